@@ -6,7 +6,11 @@ layout(location = 1) in vec4 color;
 layout(location = 2) in vec2 texCoord;
 layout(location = 3) in float texSlot;
 
-uniform mat4 u_MVP;
+//set once per scene for every program, see CameraBuffer
+layout(std140) uniform Camera
+{
+    mat4 u_ViewProjection;
+};
 
 out vec2 v_TexCoord;
 out vec4 v_Color;
@@ -17,7 +21,7 @@ void main()
     v_TexSlot = texSlot;
     v_Color = color;
     v_TexCoord = texCoord;
-    gl_Position = u_MVP * position;
+    gl_Position = u_ViewProjection * position;
 }
 
 #shader fragment
@@ -26,7 +30,7 @@ void main()
 layout(location = 0) out vec4 color;
 
 uniform vec4 u_Color;
-uniform sampler2D u_Texture[2];
+uniform sampler2D u_Texture[16];
 
 in vec2 v_TexCoord;
 in vec4 v_Color;
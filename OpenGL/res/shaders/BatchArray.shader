@@ -0,0 +1,42 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 texCoord;
+layout(location = 3) in float texLayer;
+
+layout(std140) uniform Camera
+{
+    mat4 u_ViewProjection;
+};
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+out float v_TexLayer;
+
+void main()
+{
+    v_TexLayer = texLayer;
+    v_Color = color;
+    v_TexCoord = texCoord;
+    gl_Position = u_ViewProjection * position;
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform vec4 u_Color;
+uniform sampler2DArray u_TextureArray;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+in float v_TexLayer;
+
+void main()
+{
+    vec4 texColor = texture(u_TextureArray, vec3(v_TexCoord, v_TexLayer));
+    color = texColor * u_Color * v_Color;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 texCoord;
+layout(location = 3) in float texSlot;
+
+layout(std140) uniform Camera
+{
+    mat4 u_ViewProjection;
+};
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+flat out int v_TexIndex;
+
+void main()
+{
+    v_TexIndex = int(texSlot);
+    v_Color = color;
+    v_TexCoord = texCoord;
+    gl_Position = u_ViewProjection * position;
+}
+
+#shader fragment
+#version 330 core
+#extension GL_ARB_bindless_texture : require
+
+layout(location = 0) out vec4 color;
+
+uniform vec4 u_Color;
+
+//two 64 bit texture handles per element, std140 pads smaller array elements to 16 bytes anyway
+layout(std140) uniform TextureHandles
+{
+    uvec4 u_Handles[1024];
+};
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+flat in int v_TexIndex;
+
+void main()
+{
+    uvec4 pair = u_Handles[v_TexIndex >> 1];
+    uvec2 handle = (v_TexIndex & 1) == 0 ? pair.xy : pair.zw;
+    vec4 texColor = texture(sampler2D(handle), v_TexCoord);
+    color = texColor * u_Color * v_Color;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+
+layout(std140) uniform Camera
+{
+    mat4 u_ViewProjection;
+};
+
+out vec2 v_TexCoord;
+
+void main()
+{
+    v_TexCoord = texCoord;
+    gl_Position = u_ViewProjection * vec4(position, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform sampler2D u_Texture;
+uniform float u_Time;
+uniform vec4 u_Tint;
+
+in vec2 v_TexCoord;
+
+//edit and save while the "Shader Hot Reload" test is open
+void main()
+{
+    vec2 uv = v_TexCoord;
+    float wave = sin(uv.x * 12.0 + u_Time) + sin(uv.y * 9.0 - u_Time * 1.3);
+    vec3 background = 0.5 + 0.5 * cos(wave + vec3(0.0, 2.0, 4.0));
+    vec4 texColor = texture(u_Texture, uv);
+    color = vec4(mix(background, texColor.rgb, texColor.a), 1.0) * u_Tint;
+}
\ No newline at end of file
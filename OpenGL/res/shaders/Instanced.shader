@@ -0,0 +1,39 @@
+#shader vertex
+#version 330 core
+
+//unit quad, shared by every instance
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+//per instance: x, y, size and tint
+layout(location = 2) in vec3 instance;
+layout(location = 3) in vec4 color;
+
+layout(std140) uniform Camera
+{
+    mat4 u_ViewProjection;
+};
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+
+void main()
+{
+    v_TexCoord = texCoord;
+    v_Color = color;
+    gl_Position = u_ViewProjection * vec4(instance.xy + position * instance.z, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform sampler2D u_Texture;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+
+void main()
+{
+    color = texture(u_Texture, v_TexCoord) * v_Color;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+
+layout(std140) uniform Camera
+{
+    mat4 u_ViewProjection;
+};
+uniform mat4 u_Model;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+    v_TexCoord = texCoord;
+    gl_Position = u_ViewProjection * u_Model * vec4(position, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+uniform vec4 u_Color;
+uniform sampler2D u_Texture;
+
+in vec2 v_TexCoord;
+
+void main()
+{
+    color = texture(u_Texture, v_TexCoord) * u_Color;
+}
\ No newline at end of file
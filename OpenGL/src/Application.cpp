@@ -5,6 +5,15 @@
 #include <string>
 
 #include "Renderer.h"
+#include "QuadIndexBuffer.h"
+#include "CameraBuffer.h"
+#include "GLStateCache.h"
+#include "TextureLoader.h"
+#include "TextureLibrary.h"
+#include "TextureResidency.h"
+#include "ProgramCache.h"
+#include "ShaderReloader.h"
+#include "Sampler.h"
 
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
@@ -15,6 +24,26 @@
 
 #include "tests/TestClearColor.h"
 #include "tests/TestTexture2D.h"
+#include "tests/TestStreamBuffer.h"
+#include "tests/TestInstancing.h"
+#include "tests/TestRenderQueue.h"
+#include "tests/TestMultiDraw.h"
+#include "tests/TestTextureArray.h"
+#include "tests/TestAtlas.h"
+#include "tests/TestAsyncTexture.h"
+#include "tests/TestMipmaps.h"
+#include "tests/TestCompressedTexture.h"
+#include "tests/TestTextureCache.h"
+#include "tests/TestTextureLibrary.h"
+#include "tests/TestBindless.h"
+#include "tests/TestResidency.h"
+#include "tests/TestDynamicTexture.h"
+#include "tests/TestPremultiply.h"
+#include "tests/TestProgramCache.h"
+#include "tests/TestShaderReload.h"
+#include "tests/TestShaderBatch.h"
+#include "tests/TestUniformThroughput.h"
+#include "tests/TestUniformBuffer.h"
 
 int main(void)
 {
@@ -40,14 +69,13 @@ int main(void)
 	glfwMakeContextCurrent(window);
 	glfwSwapInterval(1);
 
+	//core profile: let GLEW query the extension entry points instead of relying on the extension string
+	glewExperimental = GL_TRUE;
 	if (glewInit() != GLEW_OK)
 		std::cout << "Error" << std::endl;
 
 	std::cout << glGetString(GL_VERSION) << std::endl;
 
-	GLCall(glEnable(GL_BLEND));
-	GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-
 	{
 		// Setup Dear ImGui context
 		IMGUI_CHECKVERSION();
@@ -61,14 +89,52 @@ int main(void)
 		ImGui_ImplOpenGL3_Init("#version 130");
 
 		Renderer renderer;
+		renderer.SetBlendMode(BlendMode::Alpha);
 
 		test::TestMenu* testMenu = new test::TestMenu();
 		testMenu->ResisterTest<test::TestClearColor>("Clear Color");
 		testMenu->ResisterTest<test::TestTexture2D>("2D Texture");
+		testMenu->ResisterTest<test::TestStreamBuffer>("Stream Buffer");
+		testMenu->ResisterTest<test::TestInstancing>("Instancing");
+		testMenu->ResisterTest<test::TestRenderQueue>("Render Queue");
+		testMenu->ResisterTest<test::TestMultiDraw>("Multi Draw Indirect");
+		testMenu->ResisterTest<test::TestTextureArray>("Texture Array");
+		testMenu->ResisterTest<test::TestAtlas>("Atlas");
+		testMenu->ResisterTest<test::TestAsyncTexture>("Async Texture");
+		testMenu->ResisterTest<test::TestMipmaps>("Mipmaps");
+		testMenu->ResisterTest<test::TestCompressedTexture>("Compressed Texture");
+		testMenu->ResisterTest<test::TestTextureCache>("Texture Cache");
+		testMenu->ResisterTest<test::TestTextureLibrary>("Texture Library");
+		testMenu->ResisterTest<test::TestBindless>("Bindless Textures");
+		testMenu->ResisterTest<test::TestResidency>("Texture Residency");
+		testMenu->ResisterTest<test::TestDynamicTexture>("Dynamic Texture");
+		testMenu->ResisterTest<test::TestPremultiply>("Premultiplied Alpha");
+		testMenu->ResisterTest<test::TestProgramCache>("Program Cache");
+		testMenu->ResisterTest<test::TestShaderReload>("Shader Hot Reload");
+		testMenu->ResisterTest<test::TestShaderBatch>("Parallel Shader Compile");
+		testMenu->ResisterTest<test::TestUniformThroughput>("Uniform Throughput");
+		testMenu->ResisterTest<test::TestUniformBuffer>("Uniform Buffer");
+
+		double lastTime = glfwGetTime();
 
 		/* Loop until the user closes the window */
 		while (!glfwWindowShouldClose(window))
 		{
+			double time = glfwGetTime();
+			float deltaTime = (float)(time - lastTime);
+			lastTime = time;
+
+			//ImGui binds its own objects every frame, don't trust what was cached before
+			GLStateCache::Get().Invalidate();
+			GLStateCache::Get().ResetStats();
+
+			//finish textures decoded in the background without blowing the frame
+			TextureLoader::Get().ProcessUploads(2.0f);
+			//queue reloads of evicted textures bound last frame, then get under the video memory budget
+			TextureResidency::Get().Update();
+			//swap in shaders edited since the last frame
+			ShaderReloader::Get().Update();
+
 			renderer.Clear();
 			GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
 
@@ -78,7 +144,7 @@ int main(void)
 
 			if (testMenu->GetCurrentTest())
 			{
-				testMenu->GetCurrentTest()->OnUpdate(0.0f);
+				testMenu->GetCurrentTest()->OnUpdate(deltaTime);
 				testMenu->GetCurrentTest()->OnRender();
 
 				ImGui::Begin("Test");
@@ -102,6 +168,16 @@ int main(void)
 
 		//delete test menu
 		delete testMenu;
+
+		//shared GL resources go before the context does
+		QuadIndexBuffer::Shutdown();
+		CameraBuffer::Shutdown();
+		TextureLibrary::Shutdown();
+		TextureLoader::Shutdown();
+		TextureResidency::Shutdown();
+		SamplerCache::Shutdown();
+		ShaderReloader::Shutdown();
+		ProgramCache::Shutdown();
 	}
 
 	ImGui_ImplOpenGL3_Shutdown();
@@ -0,0 +1,143 @@
+#include "AtlasBuilder.h"
+
+#include <iostream>
+#include <string.h>
+
+#include "Renderer.h"
+#include "stb_image/stb_image.h"
+
+//imgui_draw.cpp compiles its own static copy, this one is private to the atlas builder
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/imstb_rectpack.h"
+
+AtlasBuilder::AtlasBuilder(int pageSize, int padding)
+	:m_PageSize(pageSize), m_Padding(padding), m_Alignment(1), m_MipLevels(1)
+{
+	while (m_Alignment * 2 <= m_Padding)
+	{
+		m_Alignment *= 2;
+		m_MipLevels++;
+	}
+}
+
+AtlasBuilder::~AtlasBuilder()
+{
+}
+
+int AtlasBuilder::Add(const std::string& filePath)
+{
+	int width, height, bpp;
+	stbi_set_flip_vertically_on_load_thread(1);
+	unsigned char* pixels = stbi_load(filePath.c_str(), &width, &height, &bpp, 4);
+	if (!pixels)
+	{
+		std::cout << "Failed to load " << filePath << std::endl;
+		return -1;
+	}
+
+	int id = Add(width, height, pixels);
+	stbi_image_free(pixels);
+	return id;
+}
+
+int AtlasBuilder::Add(int width, int height, const void* pixels)
+{
+	if (GetPaddedSize(width) > m_PageSize || GetPaddedSize(height) > m_PageSize)
+	{
+		std::cout << "Image of " << width << "x" << height << " doesn't fit an atlas page of " << m_PageSize << std::endl;
+		return -1;
+	}
+
+	Image image;
+	image.Width = width;
+	image.Height = height;
+	image.Pixels.resize(width * height * 4);
+	memcpy(image.Pixels.data(), pixels, image.Pixels.size());
+	m_Images.push_back(std::move(image));
+
+	m_SubTextures.push_back({ nullptr, glm::vec2(0.0f), glm::vec2(0.0f), width, height });
+	return (int)m_SubTextures.size() - 1;
+}
+
+int AtlasBuilder::GetPaddedSize(int size) const
+{
+	return (size + 2 * m_Padding + m_Alignment - 1) / m_Alignment * m_Alignment;
+}
+
+void AtlasBuilder::Blit(std::vector<unsigned char>& page, const Image& image, int x, int y) const
+{
+	//(x, y) is the corner of the padded rect, every padding texel copies the nearest image texel.
+	//rounding up to the alignment adds a few more on the right and top
+	int paddedWidth = GetPaddedSize(image.Width);
+	int paddedHeight = GetPaddedSize(image.Height);
+	for (int row = 0; row < paddedHeight; row++)
+	{
+		int srcRow = glm::clamp(row - m_Padding, 0, image.Height - 1);
+		const unsigned char* src = &image.Pixels[srcRow * image.Width * 4];
+		unsigned char* dst = &page[((y + row) * m_PageSize + x) * 4];
+
+		for (int col = 0; col < m_Padding; col++)
+			memcpy(dst + col * 4, src, 4);
+		memcpy(dst + m_Padding * 4, src, image.Width * 4);
+		for (int col = m_Padding + image.Width; col < paddedWidth; col++)
+			memcpy(dst + col * 4, src + (image.Width - 1) * 4, 4);
+	}
+}
+
+void AtlasBuilder::Build()
+{
+	std::vector<stbrp_rect> rects(m_Images.size());
+	for (size_t i = 0; i < m_Images.size(); i++)
+	{
+		rects[i].id = (int)i;
+		//packed in units of the alignment, so every rect lands on a multiple of it
+		rects[i].w = (stbrp_coord)(GetPaddedSize(m_Images[i].Width) / m_Alignment);
+		rects[i].h = (stbrp_coord)(GetPaddedSize(m_Images[i].Height) / m_Alignment);
+		rects[i].was_packed = 0;
+	}
+
+	int pageCells = m_PageSize / m_Alignment;
+	std::vector<stbrp_node> nodes(pageCells);
+	std::vector<unsigned char> pixels(m_PageSize * m_PageSize * 4);
+
+	//every round fills one page with what is left
+	while (!rects.empty())
+	{
+		stbrp_context context;
+		stbrp_init_target(&context, pageCells, pageCells, nodes.data(), (int)nodes.size());
+		stbrp_pack_rects(&context, rects.data(), (int)rects.size());
+
+		memset(pixels.data(), 0, pixels.size());
+		std::vector<stbrp_rect> remaining;
+		for (const stbrp_rect& rect : rects)
+		{
+			if (rect.was_packed)
+				Blit(pixels, m_Images[rect.id], rect.x * m_Alignment, rect.y * m_Alignment);
+			else
+				remaining.push_back(rect);
+		}
+		ASSERT(remaining.size() < rects.size());
+
+		//levels past m_MipLevels would mix neighbouring images
+		m_Pages.push_back(std::make_unique<Texture>(m_PageSize, m_PageSize, TextureFormat::RGBA8, pixels.data(), SamplerDesc(), m_MipLevels));
+		const Texture* page = m_Pages.back().get();
+
+		float texel = 1.0f / m_PageSize;
+		for (const stbrp_rect& rect : rects)
+		{
+			if (!rect.was_packed)
+				continue;
+
+			SubTexture& sub = m_SubTextures[rect.id];
+			sub.Page = page;
+			sub.UVMin = glm::vec2(rect.x * m_Alignment + m_Padding, rect.y * m_Alignment + m_Padding) * texel;
+			sub.UVMax = sub.UVMin + glm::vec2(sub.Width, sub.Height) * texel;
+		}
+
+		rects.swap(remaining);
+	}
+
+	m_Images.clear();
+	m_Images.shrink_to_fit();
+}
\ No newline at end of file
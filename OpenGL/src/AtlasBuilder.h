@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Texture.h"
+
+//an image inside an atlas page, UVs can go straight into quad vertices
+struct SubTexture
+{
+	const Texture* Page;
+	glm::vec2 UVMin;
+	glm::vec2 UVMax;
+	int Width, Height;
+};
+
+//packs many images into a few atlas pages with stb_rect_pack. every image is surrounded
+//by "padding" texels that repeat its border, so filtering never bleeds neighbours into it.
+//pages get log2(padding) + 1 mip levels (padding rounded down to a power of two): padded rects
+//start and end on multiples of 2^(levels - 1), so no texel of a smaller level mixes two images
+//and at least one gutter texel is left on every level the page has.
+class AtlasBuilder
+{
+private:
+	struct Image
+	{
+		int Width, Height;
+		std::vector<unsigned char> Pixels;
+	};
+
+	int m_PageSize;
+	int m_Padding;
+	//power of two that positions and sizes of padded rects are multiples of
+	int m_Alignment;
+	int m_MipLevels;
+	std::vector<Image> m_Images;
+	std::vector<std::unique_ptr<Texture> > m_Pages;
+	std::vector<SubTexture> m_SubTextures;
+public:
+	AtlasBuilder(int pageSize = 2048, int padding = 2);
+	~AtlasBuilder();
+
+	//queue an image for packing and return its id, -1 if it can't be loaded or is larger than a page
+	int Add(const std::string& filePath);
+	int Add(int width, int height, const void* pixels);
+
+	//pack every queued image into as few pages as possible and upload the pages.
+	//CPU copies of the images are released afterwards.
+	void Build();
+
+	inline const SubTexture& GetSubTexture(int id) const { return m_SubTextures[id]; }
+	inline unsigned int GetSubTextureCount() const { return (unsigned int)m_SubTextures.size(); }
+	inline unsigned int GetPageCount() const { return (unsigned int)m_Pages.size(); }
+	inline int GetMipLevels() const { return m_MipLevels; }
+	inline const Texture& GetPage(unsigned int page) const { return *m_Pages[page]; }
+private:
+	//size of an image with its gutter, rounded up to the alignment
+	int GetPaddedSize(int size) const;
+	void Blit(std::vector<unsigned char>& page, const Image& image, int x, int y) const;
+};
\ No newline at end of file
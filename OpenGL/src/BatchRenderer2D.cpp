@@ -0,0 +1,285 @@
+#include "BatchRenderer2D.h"
+
+#include <iostream>
+
+#include "Renderer.h"
+#include "QuadIndexBuffer.h"
+#include "GLStateCache.h"
+#include "CameraBuffer.h"
+
+BatchRenderer2D::BatchRenderer2D(const std::string& shaderPath, const std::string& arrayShaderPath)
+	:m_QuadBufferBase(nullptr), m_QuadBufferPtr(nullptr), m_IndexCount(0),
+	m_TextureSlotIndex(1), m_TextureSlotCount(MaxTextureSlots), m_BatchArray(nullptr),
+	m_Bindless(false), m_HandleBuffer(0)
+{
+	m_VAO = std::make_unique<VertexArray>();
+
+	//one region holds a full batch, so a flush never waits on the draw it just issued
+	m_VB = std::make_unique<VertexBuffer>((unsigned int)(sizeof(QuadVertex) * MaxVertexCount), (unsigned int)StreamRegionCount);
+
+	VertexBufferLayout layout;
+	layout.Push<float>(3);//positon
+	layout.Push<float>(4);//vertex color
+	layout.Push<float>(2);//texture coordinates
+	layout.Push<float>(1);//texture slot
+
+	m_VAO->AddBuffer(*m_VB, layout);
+
+	//never use more slots than the driver exposes to the fragment stage
+	int maxUnits = 0;
+	GLCall(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits));
+	if (maxUnits > 0 && (unsigned int)maxUnits < m_TextureSlotCount)
+		m_TextureSlotCount = (unsigned int)maxUnits;
+
+	unsigned int white = 0xffffffff;
+	m_WhiteTexture = std::make_unique<Texture>(1, 1, &white);
+	m_TextureSlots.fill(nullptr);
+	m_TextureSlots[0] = m_WhiteTexture.get();
+
+	m_Shader = std::make_unique<Shader>(shaderPath);
+	m_Shader->Bind();
+	m_Shader->SetUniform4f("u_Color", 1.0f, 1.0f, 1.0f, 1.0f);
+
+	int samplers[MaxTextureSlots];
+	for (unsigned int i = 0; i < MaxTextureSlots; i++)
+		samplers[i] = i;
+	m_Shader->SetUniformArrayi("u_Texture", samplers, MaxTextureSlots);
+
+	m_ArrayShader = std::make_unique<Shader>(arrayShaderPath);
+	m_ArrayShader->Bind();
+	m_ArrayShader->SetUniform4f("u_Color", 1.0f, 1.0f, 1.0f, 1.0f);
+	m_ArrayShader->SetUniform1i("u_TextureArray", 0);
+}
+
+BatchRenderer2D::~BatchRenderer2D()
+{
+	if (m_HandleBuffer)
+	{
+		GLStateCache::Get().OnDeleteBuffer(m_HandleBuffer);
+		GLCall(glDeleteBuffers(1, &m_HandleBuffer));
+	}
+}
+
+void BatchRenderer2D::SetBindless(bool bindless)
+{
+	if (bindless && !Texture::IsBindlessSupported())
+	{
+		std::cout << "Warning: ARB_bindless_texture is not supported, using texture slots" << std::endl;
+		bindless = false;
+	}
+
+	if (bindless && !m_BindlessShader)
+	{
+		//the driver may still reject the extension in GLSL 3.30, the slots keep working then
+		m_BindlessShader = std::make_unique<Shader>("res/shaders/BatchBindless.shader");
+		if (!m_BindlessShader->IsReady())
+		{
+			std::cout << "Warning: the bindless batch shader failed to build, using texture slots" << std::endl;
+			m_BindlessShader.reset();
+			m_Bindless = false;
+			return;
+		}
+		m_BindlessShader->Bind();
+		m_BindlessShader->SetUniform4f("u_Color", 1.0f, 1.0f, 1.0f, 1.0f);
+
+		GLCall(glGenBuffers(1, &m_HandleBuffer));
+		GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, m_HandleBuffer);
+		GLCall(glBufferData(GL_UNIFORM_BUFFER, sizeof(unsigned long long) * MaxBindlessTextures, nullptr, GL_STREAM_DRAW));
+		m_Handles.reserve(MaxBindlessTextures);
+	}
+	m_Bindless = bindless;
+}
+
+void BatchRenderer2D::BeginScene(const glm::mat4& viewProjection)
+{
+	//one upload for every batch shader
+	CameraBuffer::SetViewProjection(viewProjection);
+
+	m_BatchArray = nullptr;
+	StartBatch();
+}
+
+void BatchRenderer2D::EndScene()
+{
+	Flush();
+}
+
+void BatchRenderer2D::StartBatch()
+{
+	m_QuadBufferBase = (QuadVertex*)m_VB->BeginRegion();
+	m_QuadBufferPtr = m_QuadBufferBase;
+	m_IndexCount = 0;
+	m_TextureSlotIndex = 1;
+
+	if (m_Bindless)
+	{
+		m_Handles.clear();
+		m_HandleIndices.clear();
+		m_Handles.push_back(m_WhiteTexture->GetBindlessHandle());
+		m_HandleIndices[m_WhiteTexture->GetRendererID()] = 0;
+	}
+}
+
+void BatchRenderer2D::NextBatch()
+{
+	Flush();
+	StartBatch();
+}
+
+void BatchRenderer2D::Flush()
+{
+	if (m_IndexCount == 0)
+		return;
+
+	unsigned int size = (unsigned int)((m_QuadBufferPtr - m_QuadBufferBase) * sizeof(QuadVertex));
+	m_VB->CommitRegion(size);
+
+	Shader* shader = m_Shader.get();
+	if (m_BatchArray)
+	{
+		m_BatchArray->Bind(0);
+		shader = m_ArrayShader.get();
+	}
+	else if (m_Bindless)
+	{
+		//orphan the block so the upload doesn't wait on the previous batch
+		GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, m_HandleBuffer);
+		GLCall(glBufferData(GL_UNIFORM_BUFFER, sizeof(unsigned long long) * MaxBindlessTextures, nullptr, GL_STREAM_DRAW));
+		GLCall(glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(unsigned long long) * m_Handles.size(), m_Handles.data()));
+		GLStateCache::Get().BindBufferBase(GL_UNIFORM_BUFFER, UniformBuffer::GetBindingPoint("TextureHandles"), m_HandleBuffer);
+		shader = m_BindlessShader.get();
+	}
+	else
+	{
+		for (unsigned int i = 0; i < m_TextureSlotIndex; i++)
+			m_TextureSlots[i]->Bind(i);
+	}
+
+	//only draw the indices that belong to the quads of this batch
+	Renderer renderer;
+	int baseVertex = (int)(m_VB->GetRegionOffset() / sizeof(QuadVertex));
+	const IndexBuffer& ib = QuadIndexBuffer::Get(m_IndexCount / 6);
+	renderer.Draw(*m_VAO, ib, *shader, { 0, m_IndexCount, baseVertex });
+	m_Stats.DrawCalls++;
+}
+
+void BatchRenderer2D::UseTextureArray(const TextureArray* textureArray)
+{
+	if (m_BatchArray != textureArray && m_IndexCount > 0)
+		NextBatch();
+	m_BatchArray = textureArray;
+}
+
+void BatchRenderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+{
+	if (m_IndexCount >= MaxIndexCount)
+		NextBatch();
+	UseTextureArray(nullptr);
+
+	PushQuad(position, size, color, 0.0f);
+}
+
+void BatchRenderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Texture& texture, const glm::vec4& tint)
+{
+	if (m_IndexCount >= MaxIndexCount)
+		NextBatch();
+	UseTextureArray(nullptr);
+
+	//top-down images (most KTX/DDS files) are upright when V runs from the top
+	if (texture.IsOriginTop())
+		PushQuad(position, size, tint, GetTextureSlot(texture), { 0.0f, 1.0f }, { 1.0f, 0.0f });
+	else
+		PushQuad(position, size, tint, GetTextureSlot(texture));
+}
+
+void BatchRenderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const TextureArray& textureArray, unsigned int layer, const glm::vec4& tint)
+{
+	if (m_IndexCount >= MaxIndexCount)
+		NextBatch();
+	UseTextureArray(&textureArray);
+
+	PushQuad(position, size, tint, (float)layer);
+}
+
+void BatchRenderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tint)
+{
+	if (m_IndexCount >= MaxIndexCount)
+		NextBatch();
+	UseTextureArray(nullptr);
+
+	PushQuad(position, size, tint, GetTextureSlot(*subTexture.Page), subTexture.UVMin, subTexture.UVMax);
+}
+
+float BatchRenderer2D::GetTextureSlot(const Texture& texture)
+{
+	if (m_Bindless)
+		return GetTextureHandleIndex(texture);
+
+	for (unsigned int i = 1; i < m_TextureSlotIndex; i++)
+	{
+		if (m_TextureSlots[i]->GetRendererID() == texture.GetRendererID())
+			return (float)i;
+	}
+
+	//every slot is taken by another texture, start a new batch
+	if (m_TextureSlotIndex >= m_TextureSlotCount)
+		NextBatch();
+
+	unsigned int slot = m_TextureSlotIndex++;
+	m_TextureSlots[slot] = &texture;
+	return (float)slot;
+}
+
+float BatchRenderer2D::GetTextureHandleIndex(const Texture& texture)
+{
+	auto it = m_HandleIndices.find(texture.GetRendererID());
+	if (it != m_HandleIndices.end())
+		return (float)it->second;
+
+	//the handle block is full, start a new batch
+	if (m_Handles.size() >= MaxBindlessTextures)
+		NextBatch();
+
+	unsigned int index = (unsigned int)m_Handles.size();
+	m_Handles.push_back(texture.GetBindlessHandle());
+	m_HandleIndices[texture.GetRendererID()] = index;
+	return (float)index;
+}
+
+void BatchRenderer2D::PushQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, float texID,
+	const glm::vec2& uvMin, const glm::vec2& uvMax)
+{
+	float x = position.x, y = position.y;
+
+	m_QuadBufferPtr->Position = { x, y + size.y, 0.0f };
+	m_QuadBufferPtr->Color = color;
+	m_QuadBufferPtr->TexCoords = { uvMin.x, uvMax.y };
+	m_QuadBufferPtr->TexID = texID;
+	m_QuadBufferPtr++;
+
+	m_QuadBufferPtr->Position = { x + size.x, y + size.y, 0.0f };
+	m_QuadBufferPtr->Color = color;
+	m_QuadBufferPtr->TexCoords = { uvMax.x, uvMax.y };
+	m_QuadBufferPtr->TexID = texID;
+	m_QuadBufferPtr++;
+
+	m_QuadBufferPtr->Position = { x + size.x, y, 0.0f };
+	m_QuadBufferPtr->Color = color;
+	m_QuadBufferPtr->TexCoords = { uvMax.x, uvMin.y };
+	m_QuadBufferPtr->TexID = texID;
+	m_QuadBufferPtr++;
+
+	m_QuadBufferPtr->Position = { x, y, 0.0f };
+	m_QuadBufferPtr->Color = color;
+	m_QuadBufferPtr->TexCoords = { uvMin.x, uvMin.y };
+	m_QuadBufferPtr->TexID = texID;
+	m_QuadBufferPtr++;
+
+	m_IndexCount += 6;
+	m_Stats.QuadCount++;
+}
+
+void BatchRenderer2D::ResetStats()
+{
+	m_Stats = Stats();
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "glm/glm.hpp"
+
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "TextureArray.h"
+#include "AtlasBuilder.h"
+
+struct QuadVertex
+{
+	glm::vec3 Position;
+	glm::vec4 Color;
+	glm::vec2 TexCoords;
+	float TexID;
+};
+
+class BatchRenderer2D
+{
+public:
+	static const unsigned int MaxQuadCount = 10000;
+	static const unsigned int MaxVertexCount = MaxQuadCount * 4;
+	static const unsigned int MaxIndexCount = MaxQuadCount * 6;
+	//must match the size of u_Texture[] in the batch shader
+	static const unsigned int MaxTextureSlots = 16;
+	//must match the size of the TextureHandles block in the bindless shader (two handles per uvec4)
+	static const unsigned int MaxBindlessTextures = 2048;
+	//batches in flight before the vertex ring buffer waits on the GPU
+	static const unsigned int StreamRegionCount = 3;
+
+	struct Stats
+	{
+		unsigned int DrawCalls = 0;
+		unsigned int QuadCount = 0;
+	};
+private:
+	std::unique_ptr<VertexArray> m_VAO;
+	std::unique_ptr<VertexBuffer> m_VB;
+	std::unique_ptr<Shader> m_Shader;
+	//variant sampling a sampler2DArray by layer, used for quads from a TextureArray
+	std::unique_ptr<Shader> m_ArrayShader;
+	//1x1 white texture in slot 0, used by color-only quads
+	std::unique_ptr<Texture> m_WhiteTexture;
+
+	//the current batch is written straight into the streaming region of m_VB
+	QuadVertex* m_QuadBufferBase;
+	QuadVertex* m_QuadBufferPtr;
+	unsigned int m_IndexCount;
+
+	std::array<const Texture*, MaxTextureSlots> m_TextureSlots;
+	unsigned int m_TextureSlotIndex;
+	unsigned int m_TextureSlotCount;
+	//array sampled by the current batch, nullptr while batching 2D textures
+	const TextureArray* m_BatchArray;
+
+	//with ARB_bindless_texture the vertex index selects a handle from a uniform block instead of a
+	//texture unit, so a batch only breaks when the block is full
+	bool m_Bindless;
+	std::unique_ptr<Shader> m_BindlessShader;
+	unsigned int m_HandleBuffer;
+	std::vector<unsigned long long> m_Handles;
+	//texture id -> index into m_Handles for the current batch
+	std::unordered_map<unsigned int, unsigned int> m_HandleIndices;
+
+	Stats m_Stats;
+public:
+	BatchRenderer2D(const std::string& shaderPath = "res/shaders/Basic.shader",
+		const std::string& arrayShaderPath = "res/shaders/BatchArray.shader");
+	~BatchRenderer2D();
+
+	void BeginScene(const glm::mat4& viewProjection);
+	void EndScene();
+
+	//draw everything collected so far, called automatically when the batch is full
+	void Flush();
+
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Texture& texture, const glm::vec4& tint = glm::vec4(1.0f));
+	//any number of layers of one array share a batch, switching arrays or mixing in 2D textures starts a new one
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, const TextureArray& textureArray, unsigned int layer, const glm::vec4& tint = glm::vec4(1.0f));
+	//sub textures of one atlas page share a single slot
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, const SubTexture& subTexture, const glm::vec4& tint = glm::vec4(1.0f));
+
+	//switch between texture slots and bindless handles, stays off when the driver lacks support.
+	//call outside BeginScene/EndScene
+	void SetBindless(bool bindless);
+	inline bool IsBindless() const { return m_Bindless; }
+
+	inline const Stats& GetStats() const { return m_Stats; }
+	void ResetStats();
+private:
+	void StartBatch();
+	void NextBatch();
+	//flush when the batch so far samples from a different texture array (nullptr for 2D textures)
+	void UseTextureArray(const TextureArray* textureArray);
+
+	float GetTextureSlot(const Texture& texture);
+	float GetTextureHandleIndex(const Texture& texture);
+	void PushQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, float texID,
+		const glm::vec2& uvMin = glm::vec2(0.0f), const glm::vec2& uvMax = glm::vec2(1.0f));
+};
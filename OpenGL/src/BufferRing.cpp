@@ -0,0 +1,97 @@
+#include "BufferRing.h"
+
+#include "Renderer.h"
+
+BufferRing::BufferRing()
+	:m_Target(0), m_RegionSize(0), m_RegionCount(0), m_CurrentRegion(0), m_MappedData(nullptr), m_StallCount(0)
+{
+}
+
+BufferRing::~BufferRing()
+{
+	ASSERT(m_Fences.empty() && !m_MappedData);
+}
+
+void BufferRing::Create(unsigned int target, unsigned int regionSize, unsigned int regionCount)
+{
+	ASSERT(regionCount > 0);
+
+	m_Target = target;
+	m_RegionSize = regionSize;
+	m_RegionCount = regionCount;
+	m_CurrentRegion = regionCount - 1;
+	m_Fences.assign(regionCount, nullptr);
+
+	unsigned int size = regionSize * regionCount;
+	if (GLEW_ARB_buffer_storage)
+	{
+		//the mapping stays valid for the lifetime of the buffer, the fences guard reuse of each region
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		GLCall(glBufferStorage(target, size, nullptr, flags));
+		GLCall(m_MappedData = (unsigned char*)glMapBufferRange(target, 0, size, flags));
+	}
+	else
+	{
+		GLCall(glBufferData(target, size, nullptr, GL_STREAM_DRAW));
+		m_Staging.resize(regionSize);
+	}
+}
+
+void BufferRing::Release()
+{
+	for (void* fence : m_Fences)
+	{
+		if (fence)
+		{
+			GLCall(glDeleteSync((GLsync)fence));
+		}
+	}
+	m_Fences.clear();
+
+	if (m_MappedData)
+	{
+		GLCall(glUnmapBuffer(m_Target));
+		m_MappedData = nullptr;
+	}
+}
+
+void* BufferRing::BeginRegion()
+{
+	ASSERT(!m_Fences.empty());
+
+	//every command reading the current region has been issued by now, fence it before moving on
+	GLCall(m_Fences[m_CurrentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+	m_CurrentRegion = (m_CurrentRegion + 1) % m_RegionCount;
+
+	GLsync fence = (GLsync)m_Fences[m_CurrentRegion];
+	if (fence)
+	{
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		if (result == GL_TIMEOUT_EXPIRED)
+		{
+			m_StallCount++;
+			//flush once so the fence is guaranteed to signal, then wait in 1ms steps
+			GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+			while ((result = glClientWaitSync(fence, flags, 1000000)) == GL_TIMEOUT_EXPIRED)
+				flags = 0;
+		}
+		ASSERT(result != GL_WAIT_FAILED);
+		GLCall(glDeleteSync(fence));
+		m_Fences[m_CurrentRegion] = nullptr;
+	}
+
+	if (m_MappedData)
+		return m_MappedData + GetRegionOffset();
+	return m_Staging.data();
+}
+
+void BufferRing::CommitRegion(unsigned int size)
+{
+	ASSERT(size <= m_RegionSize);
+
+	//writes through the coherent mapping are already visible to the GPU
+	if (m_MappedData)
+		return;
+
+	GLCall(glBufferSubData(m_Target, GetRegionOffset(), size, m_Staging.data()));
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+//the storage of one GL buffer split into regions that are written round robin. each region is
+//fenced once the GPU commands reading it are issued and waited on before it is written again.
+//with ARB_buffer_storage the whole buffer stays mapped (persistent, coherent), otherwise writes
+//go to a staging copy that is uploaded with glBufferSubData. the owner creates the buffer object
+//and keeps it bound to the ring's target around Create(), CommitRegion() and Release().
+class BufferRing
+{
+private:
+	unsigned int m_Target;
+	unsigned int m_RegionSize;
+	unsigned int m_RegionCount;
+	unsigned int m_CurrentRegion;
+	//persistent, coherent mapping of the whole buffer (nullptr without ARB_buffer_storage)
+	unsigned char* m_MappedData;
+	//one GLsync per region, set once the commands reading that region are issued
+	std::vector<void*> m_Fences;
+	std::vector<unsigned char> m_Staging;
+	unsigned int m_StallCount;
+public:
+	BufferRing();
+	~BufferRing();
+
+	//allocate the storage of the buffer bound to "target"
+	void Create(unsigned int target, unsigned int regionSize, unsigned int regionCount);
+	//drop the fences and the mapping, call before the buffer is deleted
+	void Release();
+
+	//move to the next region, wait until the GPU is done with it and return where to write
+	void* BeginRegion();
+	//make the first "size" bytes written since BeginRegion visible to the GPU
+	void CommitRegion(unsigned int size);
+
+	inline unsigned int GetRegionOffset() const { return m_CurrentRegion * m_RegionSize; }
+	inline unsigned int GetRegionSize() const { return m_RegionSize; }
+	inline unsigned int GetRegionCount() const { return m_RegionCount; }
+	inline bool IsPersistent() const { return m_MappedData != nullptr; }
+	//number of times BeginRegion had to block on a fence
+	inline unsigned int GetStallCount() const { return m_StallCount; }
+};
\ No newline at end of file
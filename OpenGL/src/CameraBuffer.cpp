@@ -0,0 +1,26 @@
+#include "CameraBuffer.h"
+
+std::unique_ptr<UniformBuffer> CameraBuffer::s_Buffer;
+
+void CameraBuffer::SetViewProjection(const glm::mat4& viewProjection)
+{
+	if (!s_Buffer)
+	{
+		UniformBufferLayout layout;
+		layout.Push<glm::mat4>("u_ViewProjection");
+		s_Buffer = std::make_unique<UniformBuffer>("Camera", layout);
+	}
+
+	s_Buffer->Set("u_ViewProjection", viewProjection);
+	s_Buffer->Bind();
+}
+
+unsigned int CameraBuffer::GetUploadCount()
+{
+	return s_Buffer ? s_Buffer->GetUploadCount() : 0;
+}
+
+void CameraBuffer::Shutdown()
+{
+	s_Buffer.reset();
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+
+#include "glm/glm.hpp"
+
+#include "UniformBuffer.h"
+
+//the "Camera" uniform block shared by every shader:
+//	layout(std140) uniform Camera { mat4 u_ViewProjection; };
+//renderers set it once per scene, programs read it without a glUniform call of their own
+class CameraBuffer
+{
+private:
+	static std::unique_ptr<UniformBuffer> s_Buffer;
+public:
+	//upload the matrix if it changed and keep the block on its binding point
+	static void SetViewProjection(const glm::mat4& viewProjection);
+
+	//uploads of the block so far
+	static unsigned int GetUploadCount();
+
+	//release the GL buffer, must be called while the context is still current
+	static void Shutdown();
+};
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "DrawCommandBuffer.h"
+
+#include "GLStateCache.h"
+
+DrawCommandBuffer::DrawCommandBuffer(unsigned int capacity)
+	:m_RendererID(0), m_Capacity(capacity ? capacity : 1), m_Dirty(false)
+{
+	m_Commands.reserve(capacity);
+
+	if (IsSupported())
+	{
+		GLCall(glGenBuffers(1, &m_RendererID));
+		Bind();
+		GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW));
+	}
+}
+
+DrawCommandBuffer::~DrawCommandBuffer()
+{
+	if (m_RendererID)
+	{
+		GLStateCache::Get().OnDeleteBuffer(m_RendererID);
+		GLCall(glDeleteBuffers(1, &m_RendererID));
+	}
+}
+
+bool DrawCommandBuffer::IsSupported()
+{
+	return GLEW_ARB_multi_draw_indirect && GLEW_ARB_draw_indirect;
+}
+
+void DrawCommandBuffer::Add(const DrawRange& range, unsigned int instanceCount, unsigned int baseInstance)
+{
+	m_Commands.push_back({ range.Count, instanceCount, range.First, range.BaseVertex, baseInstance });
+	m_Dirty = true;
+}
+
+void DrawCommandBuffer::Clear()
+{
+	m_Commands.clear();
+	m_Dirty = true;
+}
+
+void DrawCommandBuffer::Upload()
+{
+	if (!m_RendererID || !m_Dirty)
+		return;
+
+	Bind();
+	unsigned int size = (unsigned int)(m_Commands.size() * sizeof(DrawElementsIndirectCommand));
+	if (m_Commands.size() > m_Capacity)
+	{
+		//grow geometrically, re-specifying the storage also orphans the old contents
+		while (m_Capacity < m_Commands.size())
+			m_Capacity *= 2;
+		GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW));
+	}
+	GLCall(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, m_Commands.data()));
+	m_Dirty = false;
+}
+
+void DrawCommandBuffer::Bind() const
+{
+	GLStateCache::Get().BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_RendererID);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+#include "Renderer.h"
+
+//layout defined by GL for glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand
+{
+	unsigned int Count;
+	unsigned int InstanceCount;
+	unsigned int FirstIndex;
+	int BaseVertex;
+	unsigned int BaseInstance;
+};
+
+//records indexed draws that share one vertex array, index buffer and shader,
+//so Renderer::DrawIndirect can submit all of them with a single call
+class DrawCommandBuffer
+{
+private:
+	//GL_DRAW_INDIRECT_BUFFER, stays 0 when multi draw indirect is not supported
+	unsigned int m_RendererID;
+	//commands the GPU buffer has room for
+	unsigned int m_Capacity;
+	std::vector<DrawElementsIndirectCommand> m_Commands;
+	bool m_Dirty;
+public:
+	DrawCommandBuffer(unsigned int capacity = 256);
+	~DrawCommandBuffer();
+
+	void Add(const DrawRange& range, unsigned int instanceCount = 1, unsigned int baseInstance = 0);
+	void Clear();
+
+	//copy the recorded commands to the GPU buffer if they changed since the last upload
+	void Upload();
+	void Bind() const;
+
+	inline unsigned int GetCount() const { return (unsigned int)m_Commands.size(); }
+	inline const std::vector<DrawElementsIndirectCommand>& GetCommands() const { return m_Commands; }
+
+	//glMultiDrawElementsIndirect is core in GL 4.3, older contexts fall back to one draw per command
+	static bool IsSupported();
+};
\ No newline at end of file
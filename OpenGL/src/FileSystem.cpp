@@ -0,0 +1,138 @@
+#include "FileSystem.h"
+
+#include <fstream>
+#include <sys/stat.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <dirent.h>
+#include <limits.h>
+#endif
+
+std::string FileSystem::GetCanonicalPath(const std::string& filePath)
+{
+#ifdef _WIN32
+	char buffer[_MAX_PATH];
+	if (!_fullpath(buffer, filePath.c_str(), _MAX_PATH))
+		return filePath;
+
+	//the file system is case insensitive and accepts both separators
+	std::string path = buffer;
+	for (char& c : path)
+		c = c == '\\' ? '/' : (char)tolower(c);
+	return path;
+#else
+	char buffer[PATH_MAX];
+	if (!realpath(filePath.c_str(), buffer))
+		return filePath;
+	return buffer;
+#endif
+}
+
+bool FileSystem::GetFileInfo(const std::string& filePath, unsigned long long& modifiedTime, unsigned long long& size)
+{
+#ifdef _WIN32
+	struct _stat64 info;
+	if (_stat64(filePath.c_str(), &info) != 0)
+		return false;
+#else
+	struct stat info;
+	if (stat(filePath.c_str(), &info) != 0)
+		return false;
+#endif
+	modifiedTime = (unsigned long long)info.st_mtime;
+	size = (unsigned long long)info.st_size;
+	return true;
+}
+
+bool FileSystem::CreateDirectories(const std::string& directory)
+{
+	for (size_t i = 1; i <= directory.size(); i++)
+	{
+		if (i < directory.size() && directory[i] != '/' && directory[i] != '\\')
+			continue;
+
+		std::string parent = directory.substr(0, i);
+#ifdef _WIN32
+		int result = _mkdir(parent.c_str());
+#else
+		int result = mkdir(parent.c_str(), 0755);
+#endif
+		if (result != 0 && errno != EEXIST)
+			return false;
+	}
+	return true;
+}
+
+std::vector<std::string> FileSystem::ListFiles(const std::string& directory, const std::string& extension)
+{
+	std::vector<std::string> files;
+	auto add = [&](const char* name)
+	{
+		size_t length = strlen(name);
+		if (length > extension.size() && extension.compare(0, extension.size(), name + length - extension.size()) == 0)
+			files.push_back(directory + "/" + name);
+	};
+#ifdef _WIN32
+	_finddata_t data;
+	intptr_t handle = _findfirst((directory + "/*").c_str(), &data);
+	if (handle == -1)
+		return files;
+	do
+	{
+		if (!(data.attrib & _A_SUBDIR))
+			add(data.name);
+	} while (_findnext(handle, &data) == 0);
+	_findclose(handle);
+#else
+	DIR* dir = opendir(directory.c_str());
+	if (!dir)
+		return files;
+	while (dirent* entry = readdir(dir))
+	{
+		if (entry->d_type != DT_DIR)
+			add(entry->d_name);
+	}
+	closedir(dir);
+#endif
+	return files;
+}
+
+bool FileSystem::WriteFileAtomic(const std::string& filePath, const std::function<void(std::ostream&)>& write)
+{
+	//written next to the target and renamed, so a crash never leaves a half written file
+	std::string tempPath = filePath + ".tmp";
+	{
+		std::ofstream stream(tempPath, std::ios::binary);
+		if (!stream)
+			return false;
+
+		write(stream);
+		if (!stream)
+		{
+			stream.close();
+			remove(tempPath.c_str());
+			return false;
+		}
+	}
+
+	remove(filePath.c_str());
+	return rename(tempPath.c_str(), filePath.c_str()) == 0;
+}
+
+unsigned long long FileSystem::HashFNV1a(const void* data, size_t size, unsigned long long hash)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
\ No newline at end of file
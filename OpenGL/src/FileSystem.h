@@ -0,0 +1,26 @@
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//the few file system queries the engine needs, on Windows and POSIX (no std::filesystem in C++14)
+class FileSystem
+{
+public:
+	//absolute path with "." and ".." resolved, "filePath" unchanged if it can't be resolved
+	static std::string GetCanonicalPath(const std::string& filePath);
+	//modification time and size of a file, false if it doesn't exist
+	static bool GetFileInfo(const std::string& filePath, unsigned long long& modifiedTime, unsigned long long& size);
+	//create "directory" and every missing parent
+	static bool CreateDirectories(const std::string& directory);
+	//paths of the files in "directory" whose names end in "extension", subdirectories are not searched
+	static std::vector<std::string> ListFiles(const std::string& directory, const std::string& extension);
+	//replace "filePath" with what "write" puts in the stream, which is never seen half written.
+	//false if the file can't be created or the stream fails
+	static bool WriteFileAtomic(const std::string& filePath, const std::function<void(std::ostream&)>& write);
+
+	//64 bit FNV-1a, pass a previous result as "hash" to continue it
+	static unsigned long long HashFNV1a(const void* data, size_t size, unsigned long long hash = 14695981039346656037ull);
+};
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "FileWatcher.h"
+
+#include "FileSystem.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FileWatcher::FileWatcher(unsigned int pollIntervalMs)
+	:m_Stop(false), m_PollInterval(pollIntervalMs), m_Inotify(-1)
+{
+#ifdef __linux__
+	m_Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_Inotify != -1)
+	{
+		m_Thread = std::thread(&FileWatcher::InotifyLoop, this);
+		return;
+	}
+#endif
+	m_Thread = std::thread(&FileWatcher::PollLoop, this);
+}
+
+FileWatcher::~FileWatcher()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stop = true;
+	}
+	m_Condition.notify_all();
+	m_Thread.join();
+
+#ifdef __linux__
+	if (m_Inotify != -1)
+		close(m_Inotify);
+#endif
+}
+
+void FileWatcher::Watch(const std::string& filePath)
+{
+	std::string path = FileSystem::GetCanonicalPath(filePath);
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (m_Files.find(path) != m_Files.end())
+		return;
+
+	FileState state = { 0, 0 };
+	FileSystem::GetFileInfo(path, state.ModifiedTime, state.Size);
+	m_Files[path] = state;
+
+#ifdef __linux__
+	if (m_Inotify != -1)
+	{
+		size_t slash = path.find_last_of('/');
+		std::string directory = slash == std::string::npos ? "." : path.substr(0, slash);
+		//a directory watched twice gets the same descriptor back
+		int watch = inotify_add_watch(m_Inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+		if (watch != -1)
+			m_Directories[watch] = directory;
+	}
+#endif
+}
+
+std::vector<FileWatcher::Change> FileWatcher::GetChanges()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	std::vector<Change> changes;
+	changes.swap(m_Changes);
+	return changes;
+}
+
+void FileWatcher::AddChange(const std::string& filePath)
+{
+	//called with m_Mutex held
+	for (const Change& change : m_Changes)
+	{
+		if (change.FilePath == filePath)
+			return;
+	}
+	m_Changes.push_back({ filePath, std::chrono::high_resolution_clock::now() });
+}
+
+void FileWatcher::PollLoop()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (!m_Condition.wait_for(lock, std::chrono::milliseconds(m_PollInterval), [this] { return m_Stop; }))
+	{
+		for (auto& file : m_Files)
+		{
+			FileState state = { 0, 0 };
+			//a file in the middle of being replaced may be missing for a moment, check again next time
+			if (!FileSystem::GetFileInfo(file.first, state.ModifiedTime, state.Size))
+				continue;
+
+			if (state.ModifiedTime != file.second.ModifiedTime || state.Size != file.second.Size)
+			{
+				file.second = state;
+				AddChange(file.first);
+			}
+		}
+	}
+}
+
+void FileWatcher::InotifyLoop()
+{
+#ifdef __linux__
+	alignas(inotify_event) char buffer[4096];
+	while (true)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_Stop)
+				return;
+		}
+
+		//wake up now and then to see whether the watcher is going away
+		pollfd descriptor = { m_Inotify, POLLIN, 0 };
+		if (poll(&descriptor, 1, 100) <= 0)
+			continue;
+
+		ssize_t length = read(m_Inotify, buffer, sizeof(buffer));
+		if (length <= 0)
+			continue;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		for (char* p = buffer; p < buffer + length;)
+		{
+			const inotify_event* event = (const inotify_event*)p;
+			p += sizeof(inotify_event) + event->len;
+
+			auto directory = m_Directories.find(event->wd);
+			if (event->len == 0 || directory == m_Directories.end())
+				continue;
+
+			//only the watched files of the directory matter
+			std::string path = directory->second + "/" + event->name;
+			auto file = m_Files.find(path);
+			if (file == m_Files.end())
+				continue;
+
+			FileSystem::GetFileInfo(path, file->second.ModifiedTime, file->second.Size);
+			AddChange(path);
+		}
+	}
+#endif
+}
\ No newline at end of file
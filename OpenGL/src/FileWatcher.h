@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//reports edits of a set of files from a background thread. on Linux the directories of the files are
+//watched with inotify (editors often save by renaming a new file over the old one, which a watch on the
+//file itself would lose); elsewhere, or when inotify is unavailable, the files are polled for a new
+//modification time or size.
+class FileWatcher
+{
+public:
+	struct Change
+	{
+		//canonical path, as returned by FileSystem::GetCanonicalPath
+		std::string FilePath;
+		//when the watcher noticed the edit
+		std::chrono::high_resolution_clock::time_point Time;
+	};
+private:
+	struct FileState
+	{
+		unsigned long long ModifiedTime;
+		unsigned long long Size;
+	};
+
+	std::thread m_Thread;
+	bool m_Stop;
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+
+	std::unordered_map<std::string, FileState> m_Files;
+	//each file shows up once however often it was written since the last GetChanges()
+	std::vector<Change> m_Changes;
+	unsigned int m_PollInterval;
+
+	//inotify descriptor and watch descriptor -> directory, -1 when polling
+	int m_Inotify;
+	std::unordered_map<int, std::string> m_Directories;
+public:
+	//"pollIntervalMs" is only used when polling
+	FileWatcher(unsigned int pollIntervalMs = 250);
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	//start watching "filePath", watching it again does nothing
+	void Watch(const std::string& filePath);
+
+	//files changed since the last call, oldest first
+	std::vector<Change> GetChanges();
+
+	inline bool IsUsingInotify() const { return m_Inotify != -1; }
+private:
+	void AddChange(const std::string& filePath);
+	void PollLoop();
+	void InotifyLoop();
+};
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "GLStateCache.h"
+
+#include "Renderer.h"
+
+GLStateCache::GLStateCache()
+{
+	Invalidate();
+}
+
+GLStateCache& GLStateCache::Get()
+{
+	//GL state belongs to a context, so there is one cache per GLFW window
+	static std::unordered_map<GLFWwindow*, GLStateCache> s_Caches;
+	static GLFWwindow* s_LastContext = nullptr;
+	static GLStateCache* s_LastCache = nullptr;
+
+	GLFWwindow* context = glfwGetCurrentContext();
+	if (context != s_LastContext || !s_LastCache)
+	{
+		s_LastContext = context;
+		s_LastCache = &s_Caches[context];
+	}
+	return *s_LastCache;
+}
+
+int GLStateCache::GetTextureTargetIndex(unsigned int target)
+{
+	switch (target)
+	{
+	case GL_TEXTURE_2D:			return Texture2D;
+	case GL_TEXTURE_2D_ARRAY:	return Texture2DArray;
+	default:					return -1;
+	}
+}
+
+void GLStateCache::UseProgram(unsigned int program)
+{
+	if (m_Program == program)
+	{
+		m_Stats.Elided++;
+		return;
+	}
+	GLCall(glUseProgram(program));
+	m_Program = program;
+	m_Stats.Issued++;
+}
+
+void GLStateCache::BindVertexArray(unsigned int vertexArray)
+{
+	if (m_VertexArray == vertexArray)
+	{
+		m_Stats.Elided++;
+		return;
+	}
+	GLCall(glBindVertexArray(vertexArray));
+	m_VertexArray = vertexArray;
+	m_Stats.Issued++;
+}
+
+void GLStateCache::BindBuffer(unsigned int target, unsigned int buffer)
+{
+	//an element buffer is only known if the VAO it belongs to is known
+	bool known = target != GL_ELEMENT_ARRAY_BUFFER || m_VertexArray != Unknown;
+	auto& bindings = target == GL_ELEMENT_ARRAY_BUFFER ? m_ElementBuffers : m_Buffers;
+	unsigned int key = target == GL_ELEMENT_ARRAY_BUFFER ? m_VertexArray : target;
+
+	auto it = bindings.find(key);
+	if (known && it != bindings.end() && it->second == buffer)
+	{
+		m_Stats.Elided++;
+		return;
+	}
+	GLCall(glBindBuffer(target, buffer));
+	if (known)
+		bindings[key] = buffer;
+	m_Stats.Issued++;
+}
+
+void GLStateCache::BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer)
+{
+	unsigned long long key = (unsigned long long)target << 32 | index;
+	auto it = m_IndexedBuffers.find(key);
+	if (it != m_IndexedBuffers.end() && it->second == buffer)
+	{
+		m_Stats.Elided++;
+		return;
+	}
+	GLCall(glBindBufferBase(target, index, buffer));
+	m_IndexedBuffers[key] = buffer;
+	m_Buffers[target] = buffer;
+	m_Stats.Issued++;
+}
+
+void GLStateCache::ActiveTexture(unsigned int unit)
+{
+	if (m_ActiveTexture == unit)
+	{
+		m_Stats.Elided++;
+		return;
+	}
+	GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+	m_ActiveTexture = unit;
+	m_Stats.Issued++;
+}
+
+void GLStateCache::BindTexture(unsigned int unit, unsigned int target, unsigned int texture)
+{
+	int index = GetTextureTargetIndex(target);
+	bool tracked = index >= 0 && unit < MaxTextureUnits;
+	//callers bind to edit the texture too, so the unit is selected even when the bind is skipped
+	ActiveTexture(unit);
+	if (tracked && m_Textures[unit][index] == texture)
+	{
+		m_Stats.Elided++;
+		return;
+	}
+
+	GLCall(glBindTexture(target, texture));
+	if (tracked)
+		m_Textures[unit][index] = texture;
+	m_Stats.Issued++;
+}
+
+void GLStateCache::BindSampler(unsigned int unit, unsigned int sampler)
+{
+	bool tracked = unit < MaxTextureUnits;
+	if (tracked && m_Samplers[unit] == sampler)
+	{
+		m_Stats.Elided++;
+		return;
+	}
+
+	//samplers are bound by unit index, the active unit doesn't matter
+	GLCall(glBindSampler(unit, sampler));
+	if (tracked)
+		m_Samplers[unit] = sampler;
+	m_Stats.Issued++;
+}
+
+void GLStateCache::SetBlend(bool enable, unsigned int srcFactor, unsigned int dstFactor)
+{
+	if (m_BlendEnabled != (unsigned int)enable)
+	{
+		if (enable)
+		{
+			GLCall(glEnable(GL_BLEND));
+		}
+		else
+		{
+			GLCall(glDisable(GL_BLEND));
+		}
+		m_BlendEnabled = enable;
+		m_Stats.Issued++;
+	}
+	else
+	{
+		m_Stats.Elided++;
+	}
+
+	if (!enable)
+		return;
+
+	if (m_BlendSrc == srcFactor && m_BlendDst == dstFactor)
+	{
+		m_Stats.Elided++;
+		return;
+	}
+
+	GLCall(glBlendFunc(srcFactor, dstFactor));
+	m_BlendSrc = srcFactor;
+	m_BlendDst = dstFactor;
+	m_Stats.Issued++;
+}
+
+void GLStateCache::OnDeleteProgram(unsigned int program)
+{
+	//a deleted program stays in use until something else is bound, but its name may come back
+	if (m_Program == program)
+		m_Program = Unknown;
+}
+
+void GLStateCache::OnDeleteVertexArray(unsigned int vertexArray)
+{
+	if (m_VertexArray == vertexArray)
+		m_VertexArray = 0;
+	m_ElementBuffers.erase(vertexArray);
+}
+
+void GLStateCache::OnDeleteBuffer(unsigned int buffer)
+{
+	for (auto& binding : m_Buffers)
+	{
+		if (binding.second == buffer)
+			binding.second = 0;
+	}
+	for (auto& binding : m_IndexedBuffers)
+	{
+		if (binding.second == buffer)
+			binding.second = 0;
+	}
+	//other VAOs may still reference the buffer, force a rebind for all of them
+	for (auto& binding : m_ElementBuffers)
+	{
+		if (binding.second == buffer)
+			binding.second = Unknown;
+	}
+}
+
+void GLStateCache::OnDeleteTexture(unsigned int texture)
+{
+	for (auto& unit : m_Textures)
+	{
+		for (auto& binding : unit)
+		{
+			if (binding == texture)
+				binding = 0;
+		}
+	}
+}
+
+void GLStateCache::OnDeleteSampler(unsigned int sampler)
+{
+	for (auto& binding : m_Samplers)
+	{
+		if (binding == sampler)
+			binding = 0;
+	}
+}
+
+void GLStateCache::Invalidate()
+{
+	m_Program = Unknown;
+	m_VertexArray = Unknown;
+	m_ElementBuffers.clear();
+	m_Buffers.clear();
+	m_IndexedBuffers.clear();
+	m_ActiveTexture = Unknown;
+	for (auto& unit : m_Textures)
+		unit.fill(Unknown);
+	m_Samplers.fill(Unknown);
+	m_BlendEnabled = Unknown;
+	m_BlendSrc = Unknown;
+	m_BlendDst = Unknown;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <unordered_map>
+
+//remembers what is bound in a GL context so that binding an object which is already bound
+//costs no GL call. every wrapper class binds through the cache of the current context;
+//code that changes bindings behind its back has to call Invalidate().
+class GLStateCache
+{
+public:
+	static const unsigned int MaxTextureUnits = 32;
+
+	struct Stats
+	{
+		//GL calls actually made through the cache
+		unsigned int Issued = 0;
+		//calls skipped because the state was already set
+		unsigned int Elided = 0;
+	};
+private:
+	//binding value that never matches, forces the next bind through
+	static const unsigned int Unknown = 0xffffffff;
+	//texture targets tracked per unit
+	enum TextureTarget
+	{
+		Texture2D = 0, Texture2DArray, TextureTargetCount
+	};
+
+	unsigned int m_Program;
+	unsigned int m_VertexArray;
+	//element array bindings are part of the VAO state, so they are remembered per VAO
+	std::unordered_map<unsigned int, unsigned int> m_ElementBuffers;
+	//every other buffer target, keyed by target
+	std::unordered_map<unsigned int, unsigned int> m_Buffers;
+	//indexed binding points of uniform and storage buffers, keyed by target << 32 | index
+	std::unordered_map<unsigned long long, unsigned int> m_IndexedBuffers;
+	unsigned int m_ActiveTexture;
+	std::array<std::array<unsigned int, TextureTargetCount>, MaxTextureUnits> m_Textures;
+	//sampler objects override the sampling state of whatever is bound to the unit
+	std::array<unsigned int, MaxTextureUnits> m_Samplers;
+	//GL_BLEND on/off (or Unknown) and the factors of glBlendFunc
+	unsigned int m_BlendEnabled;
+	unsigned int m_BlendSrc, m_BlendDst;
+
+	Stats m_Stats;
+public:
+	GLStateCache();
+
+	//cache of the context current on the calling thread
+	static GLStateCache& Get();
+
+	void UseProgram(unsigned int program);
+	void BindVertexArray(unsigned int vertexArray);
+	void BindBuffer(unsigned int target, unsigned int buffer);
+	//binds the whole buffer to binding point "index", this binds it to "target" as well
+	void BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer);
+	//"unit" is the index of the texture unit, not GL_TEXTURE0 + index
+	void ActiveTexture(unsigned int unit);
+	//leaves "unit" active, so the caller can go on editing the texture bound to it
+	void BindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+	void BindSampler(unsigned int unit, unsigned int sampler);
+	//the factors are left alone while blending is off
+	void SetBlend(bool enable, unsigned int srcFactor, unsigned int dstFactor);
+
+	//GL drops the bindings of deleted objects, the cache has to do the same
+	void OnDeleteProgram(unsigned int program);
+	void OnDeleteVertexArray(unsigned int vertexArray);
+	void OnDeleteBuffer(unsigned int buffer);
+	void OnDeleteTexture(unsigned int texture);
+	void OnDeleteSampler(unsigned int sampler);
+
+	//forget every binding, the next bind of anything is issued
+	void Invalidate();
+
+	inline unsigned int GetActiveTexture() const { return m_ActiveTexture; }
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline void ResetStats() { m_Stats = Stats(); }
+private:
+	static int GetTextureTargetIndex(unsigned int target);
+};
\ No newline at end of file
@@ -0,0 +1,477 @@
+#include "ImageContainer.h"
+
+#include <fstream>
+#include <iostream>
+#include <string.h>
+
+#include "GL/glew.h"
+
+static const unsigned char s_KTXIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+static const unsigned char s_KTX2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+//VkFormat values used by KTX2
+enum
+{
+	VkFormatRGBA8 = 37,
+	VkFormatBC1RGBA = 133,
+	VkFormatBC3 = 137,
+	VkFormatBC4 = 139,
+	VkFormatBC5 = 141,
+	VkFormatBC7 = 145
+};
+
+//DXGI_FORMAT values used by the DX10 extension of DDS
+enum
+{
+	DXGIFormatRGBA8 = 28,
+	DXGIFormatBC1 = 71,
+	DXGIFormatBC3 = 77,
+	DXGIFormatBC4 = 80,
+	DXGIFormatBC5 = 83,
+	DXGIFormatBC7 = 98
+};
+
+static unsigned int MakeFourCC(const char* code)
+{
+	return (unsigned int)code[0] | ((unsigned int)code[1] << 8) | ((unsigned int)code[2] << 16) | ((unsigned int)code[3] << 24);
+}
+
+template<typename T>
+static T Read(const std::vector<unsigned char>& file, size_t offset)
+{
+	T value;
+	memcpy(&value, file.data() + offset, sizeof(T));
+	return value;
+}
+
+template<typename T>
+static void Write(std::ofstream& stream, T value)
+{
+	stream.write((const char*)&value, sizeof(T));
+}
+
+static std::string GetExtension(const std::string& filePath)
+{
+	size_t dot = filePath.find_last_of('.');
+	if (dot == std::string::npos)
+		return "";
+
+	std::string extension = filePath.substr(dot + 1);
+	for (char& c : extension)
+		c = (char)tolower(c);
+	return extension;
+}
+
+//value of "key" in KTX style key/value data (uint32 size, key, 0, value, padded to 4), "" if it's missing
+static std::string FindKeyValue(const std::vector<unsigned char>& file, size_t offset, size_t length, const char* key)
+{
+	size_t end = offset + length;
+	if (end > file.size())
+		return "";
+
+	size_t keyLength = strlen(key);
+	while (offset + 4 <= end)
+	{
+		unsigned int size = Read<unsigned int>(file, offset);
+		size_t entry = offset + 4;
+		if (entry + size > end)
+			break;
+
+		if (size > keyLength && memcmp(file.data() + entry, key, keyLength) == 0 && file[entry + keyLength] == 0)
+		{
+			const char* value = (const char*)file.data() + entry + keyLength + 1;
+			size_t valueLength = size - keyLength - 1;
+			while (valueLength > 0 && value[valueLength - 1] == 0)
+				valueLength--;
+			return std::string(value, valueLength);
+		}
+		offset = entry + ((size + 3) & ~3u);
+	}
+	return "";
+}
+
+bool ImageContainer::IsContainerFile(const std::string& filePath)
+{
+	std::string extension = GetExtension(filePath);
+	return extension == "ktx" || extension == "ktx2" || extension == "dds";
+}
+
+bool ImageContainer::IsCompressed(unsigned int internalFormat)
+{
+	switch (internalFormat)
+	{
+	case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+	case GL_COMPRESSED_RED_RGTC1:
+	case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+	case GL_COMPRESSED_RG_RGTC2:
+	case GL_COMPRESSED_RGBA_BPTC_UNORM:
+		return true;
+	default:
+		return false;
+	}
+}
+
+size_t ImageContainer::GetLevelSize(unsigned int internalFormat, int width, int height)
+{
+	size_t blocks = (size_t)((width + 3) / 4) * ((height + 3) / 4);
+	switch (internalFormat)
+	{
+	case GL_RGBA8:								return (size_t)width * height * 4;
+	case GL_RGB8:								return (size_t)width * height * 3;
+	case GL_RG8:								return (size_t)width * height * 2;
+	case GL_R8:									return (size_t)width * height;
+	case GL_RGBA16F:							return (size_t)width * height * 8;
+	case GL_RGBA32F:							return (size_t)width * height * 16;
+	case GL_R32F:								return (size_t)width * height * 4;
+	case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:		return blocks * 8;
+	case GL_COMPRESSED_RED_RGTC1:				return blocks * 8;
+	case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:		return blocks * 16;
+	case GL_COMPRESSED_RG_RGTC2:				return blocks * 16;
+	case GL_COMPRESSED_RGBA_BPTC_UNORM:			return blocks * 16;
+	default:									return 0;
+	}
+}
+
+void ImageContainer::AddLevel(ImageData& image, int width, int height, const void* data)
+{
+	ImageData::Level level;
+	level.Offset = image.Data.size();
+	level.Size = GetLevelSize(image.InternalFormat, width, height);
+	level.Width = width;
+	level.Height = height;
+
+	image.Data.resize(level.Offset + level.Size);
+	memcpy(image.Data.data() + level.Offset, data, level.Size);
+	image.Levels.push_back(level);
+}
+
+bool ImageContainer::Load(const std::string& filePath, ImageData& image)
+{
+	std::ifstream stream(filePath, std::ios::binary);
+	if (!stream)
+	{
+		std::cout << "Failed to open " << filePath << std::endl;
+		return false;
+	}
+	std::vector<unsigned char> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+	image = ImageData();
+	bool loaded = false;
+	if (file.size() >= 64 && memcmp(file.data(), s_KTXIdentifier, 12) == 0)
+		loaded = LoadKTX(file, image);
+	else if (file.size() >= 80 && memcmp(file.data(), s_KTX2Identifier, 12) == 0)
+		loaded = LoadKTX2(file, image);
+	else if (file.size() >= 128 && Read<unsigned int>(file, 0) == MakeFourCC("DDS "))
+		loaded = LoadDDS(file, image);
+	else
+		std::cout << filePath << " is not a KTX, KTX2 or DDS file" << std::endl;
+
+	if (!loaded)
+	{
+		std::cout << "Failed to load " << filePath << std::endl;
+		image = ImageData();
+	}
+	return loaded;
+}
+
+bool ImageContainer::LoadKTX(const std::vector<unsigned char>& file, ImageData& image)
+{
+	//header after the identifier: 13 uint32 in the writer's byte order
+	if (Read<unsigned int>(file, 12) != 0x04030201)
+	{
+		std::cout << "Big endian KTX files are not supported" << std::endl;
+		return false;
+	}
+	unsigned int glType = Read<unsigned int>(file, 16);
+	unsigned int internalFormat = Read<unsigned int>(file, 28);
+	int width = (int)Read<unsigned int>(file, 36);
+	int height = (int)Read<unsigned int>(file, 40);
+	unsigned int depth = Read<unsigned int>(file, 44);
+	unsigned int arrayElements = Read<unsigned int>(file, 48);
+	unsigned int faces = Read<unsigned int>(file, 52);
+	unsigned int levels = Read<unsigned int>(file, 56);
+	unsigned int keyValueBytes = Read<unsigned int>(file, 60);
+
+	if (depth > 1 || arrayElements > 0 || faces != 1)
+	{
+		std::cout << "Only single 2D images are supported" << std::endl;
+		return false;
+	}
+	if ((glType != 0 && internalFormat != GL_RGBA8) || GetLevelSize(internalFormat, 1, 1) == 0)
+	{
+		std::cout << "Unsupported format 0x" << std::hex << internalFormat << std::dec << std::endl;
+		return false;
+	}
+
+	image.InternalFormat = internalFormat;
+	image.Width = width;
+	image.Height = height;
+	//"S=r,T=d" (the default) is top-down, "S=r,T=u" bottom-up
+	image.TopDown = FindKeyValue(file, 64, keyValueBytes, "KTXorientation").find("T=u") == std::string::npos;
+
+	size_t offset = 64 + keyValueBytes;
+	for (unsigned int level = 0; level < (levels ? levels : 1); level++)
+	{
+		if (offset + 4 > file.size())
+			return false;
+		unsigned int size = Read<unsigned int>(file, offset);
+		offset += 4;
+
+		int w = width >> level, h = height >> level;
+		w = w > 0 ? w : 1;
+		h = h > 0 ? h : 1;
+		if (size != GetLevelSize(internalFormat, w, h) || offset + size > file.size())
+			return false;
+
+		AddLevel(image, w, h, file.data() + offset);
+		//every level is padded to 4 bytes
+		offset += (size + 3) & ~3u;
+	}
+	return true;
+}
+
+bool ImageContainer::LoadKTX2(const std::vector<unsigned char>& file, ImageData& image)
+{
+	unsigned int vkFormat = Read<unsigned int>(file, 12);
+	int width = (int)Read<unsigned int>(file, 20);
+	int height = (int)Read<unsigned int>(file, 24);
+	unsigned int depth = Read<unsigned int>(file, 28);
+	unsigned int layers = Read<unsigned int>(file, 32);
+	unsigned int faces = Read<unsigned int>(file, 36);
+	unsigned int levels = Read<unsigned int>(file, 40);
+	unsigned int supercompression = Read<unsigned int>(file, 44);
+
+	if (supercompression != 0)
+	{
+		std::cout << "Supercompressed KTX2 files are not supported" << std::endl;
+		return false;
+	}
+	if (depth > 1 || layers > 0 || faces != 1)
+	{
+		std::cout << "Only single 2D images are supported" << std::endl;
+		return false;
+	}
+
+	switch (vkFormat)
+	{
+	case VkFormatRGBA8:		image.InternalFormat = GL_RGBA8; break;
+	case VkFormatBC1RGBA:	image.InternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+	case VkFormatBC3:		image.InternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+	case VkFormatBC4:		image.InternalFormat = GL_COMPRESSED_RED_RGTC1; break;
+	case VkFormatBC5:		image.InternalFormat = GL_COMPRESSED_RG_RGTC2; break;
+	case VkFormatBC7:		image.InternalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+	default:
+		std::cout << "Unsupported VkFormat " << vkFormat << std::endl;
+		return false;
+	}
+	image.Width = width;
+	image.Height = height;
+	//"rd" (the default) is top-down, "ru" bottom-up
+	std::string orientation = FindKeyValue(file, Read<unsigned int>(file, 56), Read<unsigned int>(file, 60), "KTXorientation");
+	image.TopDown = orientation.size() < 2 || orientation[1] != 'u';
+
+	//the level index follows the 80 byte header and lists level 0 first
+	levels = levels ? levels : 1;
+	if (80 + levels * 24 > file.size())
+		return false;
+	for (unsigned int level = 0; level < levels; level++)
+	{
+		size_t entry = 80 + level * 24;
+		unsigned long long offset = Read<unsigned long long>(file, entry);
+		unsigned long long size = Read<unsigned long long>(file, entry + 8);
+
+		int w = width >> level, h = height >> level;
+		w = w > 0 ? w : 1;
+		h = h > 0 ? h : 1;
+		if (size != GetLevelSize(image.InternalFormat, w, h) || offset + size > file.size())
+			return false;
+
+		AddLevel(image, w, h, file.data() + offset);
+	}
+	return true;
+}
+
+bool ImageContainer::LoadDDS(const std::vector<unsigned char>& file, ImageData& image)
+{
+	//DDS_HEADER starts after the magic, DDS_PIXELFORMAT at byte 76 of it
+	int height = (int)Read<unsigned int>(file, 12);
+	int width = (int)Read<unsigned int>(file, 16);
+	unsigned int levels = Read<unsigned int>(file, 28);
+	unsigned int pixelFlags = Read<unsigned int>(file, 80);
+	unsigned int fourCC = Read<unsigned int>(file, 84);
+	unsigned int caps2 = Read<unsigned int>(file, 112);
+
+	//DDSCAPS2_CUBEMAP and DDSCAPS2_VOLUME
+	if (caps2 & (0x200 | 0x200000))
+	{
+		std::cout << "Only single 2D images are supported" << std::endl;
+		return false;
+	}
+
+	size_t offset = 128;
+	//DDPF_FOURCC
+	if (!(pixelFlags & 0x4))
+	{
+		std::cout << "Only DDS files with a FourCC are supported" << std::endl;
+		return false;
+	}
+	if (fourCC == MakeFourCC("DXT1"))
+		image.InternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+	else if (fourCC == MakeFourCC("DXT5"))
+		image.InternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	else if (fourCC == MakeFourCC("ATI1") || fourCC == MakeFourCC("BC4U"))
+		image.InternalFormat = GL_COMPRESSED_RED_RGTC1;
+	else if (fourCC == MakeFourCC("ATI2") || fourCC == MakeFourCC("BC5U"))
+		image.InternalFormat = GL_COMPRESSED_RG_RGTC2;
+	else if (fourCC == MakeFourCC("DX10") && file.size() >= 148)
+	{
+		unsigned int dxgiFormat = Read<unsigned int>(file, 128);
+		unsigned int arraySize = Read<unsigned int>(file, 140);
+		offset += 20;
+		if (arraySize > 1)
+		{
+			std::cout << "Only single 2D images are supported" << std::endl;
+			return false;
+		}
+
+		switch (dxgiFormat)
+		{
+		case DXGIFormatRGBA8:	image.InternalFormat = GL_RGBA8; break;
+		case DXGIFormatBC1:		image.InternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+		case DXGIFormatBC3:		image.InternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+		case DXGIFormatBC4:		image.InternalFormat = GL_COMPRESSED_RED_RGTC1; break;
+		case DXGIFormatBC5:		image.InternalFormat = GL_COMPRESSED_RG_RGTC2; break;
+		case DXGIFormatBC7:		image.InternalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+		default:
+			std::cout << "Unsupported DXGI format " << dxgiFormat << std::endl;
+			return false;
+		}
+	}
+	else
+	{
+		std::cout << "Unsupported DDS FourCC" << std::endl;
+		return false;
+	}
+	image.Width = width;
+	image.Height = height;
+	//DDS has no orientation field, the files are always top-down
+	image.TopDown = true;
+
+	//levels are stored back to back, largest first
+	for (unsigned int level = 0; level < (levels ? levels : 1); level++)
+	{
+		int w = width >> level, h = height >> level;
+		w = w > 0 ? w : 1;
+		h = h > 0 ? h : 1;
+		size_t size = GetLevelSize(image.InternalFormat, w, h);
+		if (offset + size > file.size())
+			return false;
+
+		AddLevel(image, w, h, file.data() + offset);
+		offset += size;
+	}
+	return true;
+}
+
+bool ImageContainer::WriteKTX(const std::string& filePath, const ImageData& image)
+{
+	std::ofstream stream(filePath, std::ios::binary);
+	if (!stream)
+	{
+		std::cout << "Failed to create " << filePath << std::endl;
+		return false;
+	}
+
+	bool compressed = IsCompressed(image.InternalFormat);
+	stream.write((const char*)s_KTXIdentifier, 12);
+	Write<unsigned int>(stream, 0x04030201);
+	//glType, glTypeSize and glFormat are 0 / 1 / 0 for compressed data
+	Write<unsigned int>(stream, compressed ? 0 : GL_UNSIGNED_BYTE);
+	Write<unsigned int>(stream, 1);
+	Write<unsigned int>(stream, compressed ? 0 : GL_RGBA);
+	Write<unsigned int>(stream, image.InternalFormat);
+	Write<unsigned int>(stream, compressed ? image.InternalFormat : GL_RGBA);
+	Write<unsigned int>(stream, image.Width);
+	Write<unsigned int>(stream, image.Height);
+	Write<unsigned int>(stream, 0);
+	Write<unsigned int>(stream, 0);
+	Write<unsigned int>(stream, 1);
+	Write<unsigned int>(stream, (unsigned int)image.Levels.size());
+
+	//a single key/value pair saying which way the rows are stored
+	const char topDownOrientation[] = "KTXorientation\0S=r,T=d";
+	const char bottomUpOrientation[] = "KTXorientation\0S=r,T=u";
+	const char* orientation = image.TopDown ? topDownOrientation : bottomUpOrientation;
+	const char padding[3] = { 0, 0, 0 };
+	unsigned int orientationSize = (unsigned int)sizeof(topDownOrientation);
+	unsigned int orientationPadding = ((orientationSize + 3) & ~3u) - orientationSize;
+	Write<unsigned int>(stream, 4 + orientationSize + orientationPadding);
+	Write<unsigned int>(stream, orientationSize);
+	stream.write(orientation, orientationSize);
+	stream.write(padding, orientationPadding);
+
+	for (size_t level = 0; level < image.Levels.size(); level++)
+	{
+		unsigned int size = (unsigned int)image.Levels[level].Size;
+		Write<unsigned int>(stream, size);
+		stream.write((const char*)image.GetLevelData(level), size);
+		stream.write(padding, ((size + 3) & ~3u) - size);
+	}
+	return (bool)stream;
+}
+
+bool ImageContainer::WriteDDS(const std::string& filePath, const ImageData& image)
+{
+	if (!image.TopDown)
+	{
+		std::cout << "DDS files are read top row first, " << filePath << " needs a top-down image" << std::endl;
+		return false;
+	}
+
+	std::ofstream stream(filePath, std::ios::binary);
+	if (!stream)
+	{
+		std::cout << "Failed to create " << filePath << std::endl;
+		return false;
+	}
+
+	unsigned int dxgiFormat = 0;
+	switch (image.InternalFormat)
+	{
+	case GL_RGBA8:								dxgiFormat = DXGIFormatRGBA8; break;
+	case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:		dxgiFormat = DXGIFormatBC1; break;
+	case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:		dxgiFormat = DXGIFormatBC3; break;
+	case GL_COMPRESSED_RED_RGTC1:				dxgiFormat = DXGIFormatBC4; break;
+	case GL_COMPRESSED_RG_RGTC2:				dxgiFormat = DXGIFormatBC5; break;
+	case GL_COMPRESSED_RGBA_BPTC_UNORM:			dxgiFormat = DXGIFormatBC7; break;
+	}
+
+	//every format goes through the DX10 header, which names all of them unambiguously
+	unsigned int header[31] = {};
+	header[0] = 124;
+	//DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE
+	header[1] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000;
+	header[2] = image.Height;
+	header[3] = image.Width;
+	header[4] = image.Levels.empty() ? 0 : (unsigned int)image.Levels[0].Size;
+	header[6] = (unsigned int)image.Levels.size();
+	//DDS_PIXELFORMAT: size, DDPF_FOURCC, "DX10"
+	header[18] = 32;
+	header[19] = 0x4;
+	header[20] = MakeFourCC("DX10");
+	//DDSCAPS_TEXTURE | DDSCAPS_MIPMAP | DDSCAPS_COMPLEX
+	header[26] = 0x1000 | (image.Levels.size() > 1 ? 0x400000 | 0x8 : 0);
+
+	Write<unsigned int>(stream, MakeFourCC("DDS "));
+	stream.write((const char*)header, sizeof(header));
+	//DDS_HEADER_DXT10: format, D3D10_RESOURCE_DIMENSION_TEXTURE2D, no flags, one element
+	Write<unsigned int>(stream, dxgiFormat);
+	Write<unsigned int>(stream, 3);
+	Write<unsigned int>(stream, 0);
+	Write<unsigned int>(stream, 1);
+	Write<unsigned int>(stream, 0);
+
+	for (size_t level = 0; level < image.Levels.size(); level++)
+		stream.write((const char*)image.GetLevelData(level), image.Levels[level].Size);
+	return (bool)stream;
+}
\ No newline at end of file
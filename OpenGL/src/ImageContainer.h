@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+//texels of a texture file in the format the GPU samples them in, with every stored mip level.
+//rows are uploaded in the order they are stored, see TopDown.
+struct ImageData
+{
+	struct Level
+	{
+		size_t Offset;
+		size_t Size;
+		int Width, Height;
+	};
+
+	//GL_RGBA8 or one of the GL_COMPRESSED_* block formats
+	unsigned int InternalFormat = 0;
+	int Width = 0, Height = 0;
+	//level 0 first, offsets into Data
+	std::vector<Level> Levels;
+	std::vector<unsigned char> Data;
+	//when set, the level offsets point into this memory (e.g. a mapped file) instead of Data
+	const unsigned char* External = nullptr;
+	//first row is the top of the image, as in most KTX/DDS files, instead of the bottom as OpenGL
+	//expects. block compressed rows can't be flipped without re-encoding, so the drawer flips V
+	bool TopDown = false;
+
+	inline const unsigned char* GetLevelData(size_t level) const { return (External ? External : Data.data()) + Levels[level].Offset; }
+};
+
+//reads and writes KTX, KTX2 and DDS containers. no GL calls, so tools can use it too.
+class ImageContainer
+{
+public:
+	//true for .ktx, .ktx2 and .dds paths
+	static bool IsContainerFile(const std::string& filePath);
+
+	//detects the container from its magic bytes, false (with a message) if it can't be read
+	//or holds something other than a single 2D image in a supported format.
+	//KTX2 files must not be supercompressed. TopDown comes from KTXorientation, DDS is always top-down
+	static bool Load(const std::string& filePath, ImageData& image);
+
+	//KTX records the row order of "image" in KTXorientation
+	static bool WriteKTX(const std::string& filePath, const ImageData& image);
+	//DDS has no orientation field and is read top row first, false (with a message) unless "image" is TopDown
+	static bool WriteDDS(const std::string& filePath, const ImageData& image);
+
+	static bool IsCompressed(unsigned int internalFormat);
+	//bytes of one "width" x "height" level, 0 for unsupported formats
+	static size_t GetLevelSize(unsigned int internalFormat, int width, int height);
+	//append a level to "image", computing its size from the format
+	static void AddLevel(ImageData& image, int width, int height, const void* data);
+private:
+	static bool LoadKTX(const std::vector<unsigned char>& file, ImageData& image);
+	static bool LoadKTX2(const std::vector<unsigned char>& file, ImageData& image);
+	static bool LoadDDS(const std::vector<unsigned char>& file, ImageData& image);
+};
\ No newline at end of file
@@ -2,29 +2,83 @@
 
 #include "Renderer.h"
 #include "IndexBuffer.h"
+#include "GLStateCache.h"
 
-IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
-	:m_Count(count)
+IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count, unsigned int mode)
+	:m_Count(count), m_Type(GL_UNSIGNED_INT), m_Mode(mode)
 {
 	//check whether the size of GLuint 4 bytes
 	ASSERT(sizeof(unsigned int) == sizeof(GLuint));
 
 	GLCall(glGenBuffers(1, &m_RendererID));
-	GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
-	GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_DYNAMIC_DRAW));
+	SetData(data, count);
+}
+
+IndexBuffer::IndexBuffer(const unsigned short* data, unsigned int count, unsigned int mode)
+	:m_Count(count), m_Type(GL_UNSIGNED_SHORT), m_Mode(mode)
+{
+	ASSERT(sizeof(unsigned short) == sizeof(GLushort));
+
+	GLCall(glGenBuffers(1, &m_RendererID));
+	SetData(data, count);
+}
+
+IndexBuffer::IndexBuffer(const unsigned char* data, unsigned int count, unsigned int mode)
+	:m_Count(count), m_Type(GL_UNSIGNED_BYTE), m_Mode(mode)
+{
+	GLCall(glGenBuffers(1, &m_RendererID));
+	SetData(data, count);
 }
 
 IndexBuffer::~IndexBuffer()
 {
+	GLStateCache::Get().OnDeleteBuffer(m_RendererID);
 	GLCall(glDeleteBuffers(1, &m_RendererID));
 }
 
+unsigned int IndexBuffer::GetSizeOfType(unsigned int type)
+{
+	switch (type)
+	{
+	case GL_UNSIGNED_INT:	return 4;
+	case GL_UNSIGNED_SHORT:	return 2;
+	case GL_UNSIGNED_BYTE:	return 1;
+	default:
+		ASSERT(false);
+		return 0;
+	}
+}
+
+void IndexBuffer::Upload(const void* data, unsigned int count, unsigned int type)
+{
+	m_Count = count;
+	m_Type = type;
+
+	Bind();
+	GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * GetSizeOfType(type), data, GL_DYNAMIC_DRAW));
+}
+
+void IndexBuffer::SetData(const unsigned int* data, unsigned int count)
+{
+	Upload(data, count, GL_UNSIGNED_INT);
+}
+
+void IndexBuffer::SetData(const unsigned short* data, unsigned int count)
+{
+	Upload(data, count, GL_UNSIGNED_SHORT);
+}
+
+void IndexBuffer::SetData(const unsigned char* data, unsigned int count)
+{
+	Upload(data, count, GL_UNSIGNED_BYTE);
+}
+
 void IndexBuffer::Bind() const
 {
-	GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+	GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 }
 
 void IndexBuffer::UnBind() const
 {
-	GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+	GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
\ No newline at end of file
@@ -1,16 +1,37 @@
 #pragma once
 
+#include "GL/glew.h"
+
 class IndexBuffer
 {
 private:
 	unsigned int m_RendererID;
 	unsigned int m_Count;
+	//GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	unsigned int m_Type;
+	//primitive the indices describe, e.g. GL_TRIANGLES or GL_LINES
+	unsigned int m_Mode;
 public:
-	IndexBuffer(const unsigned int* data, unsigned int count);
+	IndexBuffer(const unsigned int* data, unsigned int count, unsigned int mode = GL_TRIANGLES);
+	IndexBuffer(const unsigned short* data, unsigned int count, unsigned int mode = GL_TRIANGLES);
+	IndexBuffer(const unsigned char* data, unsigned int count, unsigned int mode = GL_TRIANGLES);
 	~IndexBuffer();
 
+	//re-specify the whole buffer, the GL object is kept
+	void SetData(const unsigned int* data, unsigned int count);
+	void SetData(const unsigned short* data, unsigned int count);
+	void SetData(const unsigned char* data, unsigned int count);
+
 	void Bind() const;
 	void UnBind() const;
 
 	inline unsigned int GetCount() const { return m_Count; }
+	inline unsigned int GetType() const { return m_Type; }
+	inline unsigned int GetMode() const { return m_Mode; }
+	inline void SetMode(unsigned int mode) { m_Mode = mode; }
+
+	static unsigned int GetSizeOfType(unsigned int type);
+	inline unsigned int GetElementSize() const { return GetSizeOfType(m_Type); }
+private:
+	void Upload(const void* data, unsigned int count, unsigned int type);
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+	:m_Data(nullptr), m_Size(0),
+#ifdef _WIN32
+	m_File(INVALID_HANDLE_VALUE), m_Mapping(nullptr)
+#else
+	m_File(-1)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::string& filePath)
+{
+	Close();
+
+#ifdef _WIN32
+	m_File = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_File == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_File, &size) || size.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+	m_Size = (size_t)size.QuadPart;
+
+	m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_Mapping)
+	{
+		Close();
+		return false;
+	}
+	m_Data = (const unsigned char*)MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	m_File = open(filePath.c_str(), O_RDONLY);
+	if (m_File < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(m_File, &info) != 0 || info.st_size == 0)
+	{
+		Close();
+		return false;
+	}
+	m_Size = (size_t)info.st_size;
+
+	void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0);
+	m_Data = data == MAP_FAILED ? nullptr : (const unsigned char*)data;
+#endif
+
+	if (!m_Data)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (m_Data)
+		UnmapViewOfFile(m_Data);
+	if (m_Mapping)
+		CloseHandle(m_Mapping);
+	if (m_File != INVALID_HANDLE_VALUE)
+		CloseHandle(m_File);
+	m_Mapping = nullptr;
+	m_File = INVALID_HANDLE_VALUE;
+#else
+	if (m_Data)
+		munmap((void*)m_Data, m_Size);
+	if (m_File >= 0)
+		close(m_File);
+	m_File = -1;
+#endif
+	m_Data = nullptr;
+	m_Size = 0;
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+//read only memory mapping of a whole file. pages are loaded on first touch,
+//so handing the pointer to GL uploads straight from the page cache.
+class MappedFile
+{
+private:
+	const unsigned char* m_Data;
+	size_t m_Size;
+#ifdef _WIN32
+	void* m_File;
+	void* m_Mapping;
+#else
+	int m_File;
+#endif
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//map "filePath", closing whatever was mapped before. false if the file can't be mapped
+	bool Open(const std::string& filePath);
+	void Close();
+
+	inline bool IsOpen() const { return m_Data != nullptr; }
+	inline const unsigned char* GetData() const { return m_Data; }
+	inline size_t GetSize() const { return m_Size; }
+};
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "MipGenerator.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define MIP_GENERATOR_SSE2
+#include <emmintrin.h>
+#endif
+
+int MipGenerator::GetLevelCount(int width, int height)
+{
+	int size = width > height ? width : height;
+	int levels = 1;
+	while (size > 1)
+	{
+		size >>= 1;
+		levels++;
+	}
+	return levels;
+}
+
+void MipGenerator::Downsample(const unsigned char* src, int width, int height, unsigned char* dst)
+{
+	int dstWidth = width > 1 ? width / 2 : 1;
+	int dstHeight = height > 1 ? height / 2 : 1;
+
+	for (int y = 0; y < dstHeight; y++)
+	{
+		//a single row or column is averaged with itself
+		const unsigned char* row0 = src + (y * 2) * width * 4;
+		const unsigned char* row1 = src + (height > 1 ? y * 2 + 1 : 0) * width * 4;
+		unsigned char* out = dst + y * dstWidth * 4;
+
+		int x = 0;
+#ifdef MIP_GENERATOR_SSE2
+		//two output texels from four input texels of each row per step
+		if (width > 1)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i round = _mm_set1_epi16(2);
+			for (; x + 2 <= dstWidth; x += 2)
+			{
+				__m128i a = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+				__m128i b = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+
+				//vertical sums of texels 0,1 and 2,3 in 16 bits
+				__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+				__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+				//horizontal sums: texel 0 + 1 and texel 2 + 3
+				__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+
+				sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+				_mm_storel_epi64((__m128i*)(out + x * 4), _mm_packus_epi16(sum, sum));
+			}
+		}
+#endif
+		for (; x < dstWidth; x++)
+		{
+			int x0 = x * 2;
+			int x1 = width > 1 ? x * 2 + 1 : x0;
+			for (int c = 0; c < 4; c++)
+			{
+				int sum = row0[x0 * 4 + c] + row0[x1 * 4 + c] + row1[x0 * 4 + c] + row1[x1 * 4 + c];
+				out[x * 4 + c] = (unsigned char)((sum + 2) >> 2);
+			}
+		}
+	}
+}
+
+std::vector<std::vector<unsigned char> > MipGenerator::BuildChain(const unsigned char* pixels, int width, int height)
+{
+	std::vector<std::vector<unsigned char> > chain;
+	const unsigned char* src = pixels;
+	while (width > 1 || height > 1)
+	{
+		int dstWidth = width > 1 ? width / 2 : 1;
+		int dstHeight = height > 1 ? height / 2 : 1;
+
+		chain.emplace_back(dstWidth * dstHeight * 4);
+		Downsample(src, width, height, chain.back().data());
+
+		src = chain.back().data();
+		width = dstWidth;
+		height = dstHeight;
+	}
+	return chain;
+}
\ No newline at end of file
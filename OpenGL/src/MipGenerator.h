@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+
+//CPU mip generation for RGBA8 images, for tools and for uploading a precomputed chain.
+//each level is a 2x2 box filter of the one above (odd edges drop their last texel).
+class MipGenerator
+{
+public:
+	//1 + floor(log2(max(width, height)))
+	static int GetLevelCount(int width, int height);
+
+	//write the next level of a "width" x "height" image into "dst", which holds
+	//max(width / 2, 1) x max(height / 2, 1) texels
+	static void Downsample(const unsigned char* src, int width, int height, unsigned char* dst);
+
+	//every level below the base, level 1 first
+	static std::vector<std::vector<unsigned char> > BuildChain(const unsigned char* pixels, int width, int height);
+};
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "PixelConverter.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define PIXEL_CONVERTER_SSE2
+#include <emmintrin.h>
+#endif
+
+//AVX2 code is compiled without /arch:AVX2 and only called after the CPU check
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define PIXEL_CONVERTER_AVX2
+#define PIXEL_CONVERTER_AVX2_TARGET
+#include <intrin.h>
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PIXEL_CONVERTER_AVX2
+#define PIXEL_CONVERTER_AVX2_TARGET __attribute__((target("avx2")))
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+static void PremultiplyScalar(unsigned char* pixels, size_t pixelCount)
+{
+	for (size_t i = 0; i < pixelCount * 4; i += 4)
+	{
+		unsigned int alpha = pixels[i + 3];
+		for (int c = 0; c < 3; c++)
+			pixels[i + c] = (unsigned char)((pixels[i + c] * alpha + 127) / 255);
+	}
+}
+
+//x / 255 rounded to nearest without a division, exact for x <= 255 * 255:
+//t = x + 128, (t + (t >> 8)) >> 8. the alpha lane is multiplied by 255, which leaves it unchanged
+
+#ifdef PIXEL_CONVERTER_SSE2
+static size_t PremultiplySSE2(unsigned char* pixels, size_t pixelCount)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i round = _mm_set1_epi16(128);
+	const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+	const __m128i alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+	//four pixels per step, two in each 16 bit half
+	size_t i = 0;
+	for (; i + 4 <= pixelCount; i += 4)
+	{
+		__m128i src = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+		__m128i halves[2] = { _mm_unpacklo_epi8(src, zero), _mm_unpackhi_epi8(src, zero) };
+		for (int h = 0; h < 2; h++)
+		{
+			__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(halves[h], 0xff), 0xff);
+			alpha = _mm_or_si128(_mm_and_si128(alpha, colorMask), alphaOne);
+			__m128i t = _mm_add_epi16(_mm_mullo_epi16(halves[h], alpha), round);
+			halves[h] = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+		}
+		_mm_storeu_si128((__m128i*)(pixels + i * 4), _mm_packus_epi16(halves[0], halves[1]));
+	}
+	return i;
+}
+#endif
+
+#ifdef PIXEL_CONVERTER_AVX2
+PIXEL_CONVERTER_AVX2_TARGET
+static size_t PremultiplyAVX2(unsigned char* pixels, size_t pixelCount)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i round = _mm256_set1_epi16(128);
+	const __m256i colorMask = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+	const __m256i alphaOne = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+
+	//eight pixels per step, unpack and pack both stay within 128 bit lanes so the order holds
+	size_t i = 0;
+	for (; i + 8 <= pixelCount; i += 8)
+	{
+		__m256i src = _mm256_loadu_si256((const __m256i*)(pixels + i * 4));
+		__m256i lo = _mm256_unpacklo_epi8(src, zero);
+		__m256i hi = _mm256_unpackhi_epi8(src, zero);
+
+		__m256i alphaLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xff), 0xff);
+		__m256i alphaHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xff), 0xff);
+		alphaLo = _mm256_or_si256(_mm256_and_si256(alphaLo, colorMask), alphaOne);
+		alphaHi = _mm256_or_si256(_mm256_and_si256(alphaHi, colorMask), alphaOne);
+
+		__m256i tLo = _mm256_add_epi16(_mm256_mullo_epi16(lo, alphaLo), round);
+		__m256i tHi = _mm256_add_epi16(_mm256_mullo_epi16(hi, alphaHi), round);
+		lo = _mm256_srli_epi16(_mm256_add_epi16(tLo, _mm256_srli_epi16(tLo, 8)), 8);
+		hi = _mm256_srli_epi16(_mm256_add_epi16(tHi, _mm256_srli_epi16(tHi, 8)), 8);
+
+		_mm256_storeu_si256((__m256i*)(pixels + i * 4), _mm256_packus_epi16(lo, hi));
+	}
+	return i;
+}
+
+static bool IsAVX2Supported()
+{
+	//the CPU has to support AVX2 and the OS has to save the YMM registers
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0, avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+SimdLevel PixelConverter::GetSimdLevel()
+{
+	static const SimdLevel level = []()
+	{
+#ifdef PIXEL_CONVERTER_AVX2
+		if (IsAVX2Supported())
+			return SimdLevel::AVX2;
+#endif
+#ifdef PIXEL_CONVERTER_SSE2
+		return SimdLevel::SSE2;
+#else
+		return SimdLevel::Scalar;
+#endif
+	}();
+	return level;
+}
+
+const char* PixelConverter::GetSimdLevelName(SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::SSE2:	return "SSE2";
+	case SimdLevel::AVX2:	return "AVX2";
+	default:				return "Scalar";
+	}
+}
+
+void PixelConverter::Premultiply(unsigned char* pixels, size_t pixelCount)
+{
+	Premultiply(pixels, pixelCount, GetSimdLevel());
+}
+
+void PixelConverter::Premultiply(unsigned char* pixels, size_t pixelCount, SimdLevel level)
+{
+	if (level > GetSimdLevel())
+		level = GetSimdLevel();
+
+	size_t done = 0;
+#ifdef PIXEL_CONVERTER_AVX2
+	if (level == SimdLevel::AVX2)
+		done = PremultiplyAVX2(pixels, pixelCount);
+#endif
+#ifdef PIXEL_CONVERTER_SSE2
+	if (level >= SimdLevel::SSE2)
+		done += PremultiplySSE2(pixels + done * 4, pixelCount - done);
+#endif
+	//whatever is left over the last full vector
+	PremultiplyScalar(pixels + done * 4, pixelCount - done);
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stddef.h>
+
+//instruction sets a conversion can run with, the best one the CPU and OS support is picked at run time
+enum class SimdLevel
+{
+	Scalar, SSE2, AVX2
+};
+
+//CPU conversions of RGBA8 pixels done once at load time
+class PixelConverter
+{
+public:
+	//best level this build and the running CPU support, detected once
+	static SimdLevel GetSimdLevel();
+	static const char* GetSimdLevelName(SimdLevel level);
+
+	//color channels multiplied by alpha, rounded to nearest: c' = (c * a + 127) / 255
+	static void Premultiply(unsigned char* pixels, size_t pixelCount);
+	//same with a given level, for comparing them. levels above GetSimdLevel() fall back to it
+	static void Premultiply(unsigned char* pixels, size_t pixelCount, SimdLevel level);
+};
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "PixelUnpackBuffer.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+PixelUnpackBuffer::PixelUnpackBuffer(unsigned int regionSize, unsigned int regionCount)
+{
+	GLCall(glGenBuffers(1, &m_RendererID));
+	Bind();
+	m_Ring.Create(GL_PIXEL_UNPACK_BUFFER, regionSize, regionCount);
+
+	//a bound unpack buffer turns every client memory upload into an offset, never leave it bound
+	UnBind();
+}
+
+PixelUnpackBuffer::~PixelUnpackBuffer()
+{
+	Bind();
+	m_Ring.Release();
+	UnBind();
+	GLStateCache::Get().OnDeleteBuffer(m_RendererID);
+	GLCall(glDeleteBuffers(1, &m_RendererID));
+}
+
+void* PixelUnpackBuffer::BeginRegion()
+{
+	return m_Ring.BeginRegion();
+}
+
+const void* PixelUnpackBuffer::CommitRegion(unsigned int size)
+{
+	Bind();
+	m_Ring.CommitRegion(size);
+	return (const void*)(size_t)m_Ring.GetRegionOffset();
+}
+
+void PixelUnpackBuffer::Bind() const
+{
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_RendererID);
+}
+
+void PixelUnpackBuffer::UnBind() const
+{
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "BufferRing.h"
+
+//ring of staging regions bound as GL_PIXEL_UNPACK_BUFFER. pixels written into a region are
+//copied into a texture by glTexSubImage2D with a buffer offset, so the copy runs on the GPU's
+//schedule instead of blocking on client memory.
+class PixelUnpackBuffer
+{
+private:
+	unsigned int m_RendererID;
+	BufferRing m_Ring;
+public:
+	PixelUnpackBuffer(unsigned int regionSize, unsigned int regionCount = 3);
+	~PixelUnpackBuffer();
+
+	void Bind() const;
+	void UnBind() const;
+
+	//move to the next region, wait until the GPU is done with it and return where to write
+	void* BeginRegion();
+	//make the first "size" bytes written since BeginRegion visible to the GPU. the buffer is left
+	//bound, the returned pointer is the region offset to pass as the pixels of glTexSubImage2D.
+	const void* CommitRegion(unsigned int size);
+
+	inline unsigned int GetRegionOffset() const { return m_Ring.GetRegionOffset(); }
+	inline unsigned int GetRegionSize() const { return m_Ring.GetRegionSize(); }
+	inline unsigned int GetRegionCount() const { return m_Ring.GetRegionCount(); }
+	inline bool IsPersistent() const { return m_Ring.IsPersistent(); }
+	//number of times BeginRegion had to block on a fence
+	inline unsigned int GetStallCount() const { return m_Ring.GetStallCount(); }
+};
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "ProgramCache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "Renderer.h"
+#include "Shader.h"
+#include "FileSystem.h"
+
+std::unique_ptr<ProgramCache> ProgramCache::s_Instance;
+
+struct ProgramCacheHeader
+{
+	char Magic[4];
+	unsigned int Version;
+	unsigned long long Key;
+	unsigned int BinaryFormat;
+	unsigned int BinarySize;
+};
+
+static const char s_Magic[4] = { 'G', 'L', 'P', 'B' };
+
+static unsigned long long HashString(const char* string, unsigned long long hash)
+{
+	//the terminator keeps "ab" + "c" apart from "a" + "bc"
+	return string ? FileSystem::HashFNV1a(string, strlen(string) + 1, hash) : hash;
+}
+
+ProgramCache::ProgramCache(const std::string& directory)
+	:m_Directory(directory), m_DriverHash(0), m_Supported(false), m_Enabled(true)
+{
+	int formatCount = 0;
+	if (GLEW_ARB_get_program_binary)
+	{
+		GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+	}
+	m_Supported = formatCount > 0;
+	if (!m_Supported)
+		return;
+
+	//a binary is only good for the driver that made it, in one of the formats it offers
+	std::vector<int> formats(formatCount);
+	GLCall(glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data()));
+	unsigned long long hash = FileSystem::HashFNV1a(formats.data(), formats.size() * sizeof(int));
+	GLCall(hash = HashString((const char*)glGetString(GL_VENDOR), hash));
+	GLCall(hash = HashString((const char*)glGetString(GL_RENDERER), hash));
+	GLCall(hash = HashString((const char*)glGetString(GL_VERSION), hash));
+	m_DriverHash = hash;
+
+	if (!FileSystem::CreateDirectories(m_Directory))
+		std::cout << "Failed to create the program cache directory " << m_Directory << std::endl;
+}
+
+ProgramCache& ProgramCache::Get()
+{
+	if (!s_Instance)
+		s_Instance = std::make_unique<ProgramCache>();
+	return *s_Instance;
+}
+
+void ProgramCache::Shutdown()
+{
+	s_Instance.reset();
+}
+
+unsigned long long ProgramCache::GetKey(const ShaderSource& source) const
+{
+	unsigned long long hash = HashString(source.VertexSource.c_str(), m_DriverHash);
+	hash = HashString(source.FragmentSource.c_str(), hash);
+	unsigned int version = FormatVersion;
+	return FileSystem::HashFNV1a(&version, sizeof(version), hash);
+}
+
+std::string ProgramCache::GetCachePath(unsigned long long key) const
+{
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.progbin", key);
+	return m_Directory + "/" + name;
+}
+
+unsigned int ProgramCache::Load(const ShaderSource& source)
+{
+	if (!IsEnabled())
+		return 0;
+
+	unsigned long long key = GetKey(source);
+	std::string cachePath = GetCachePath(key);
+
+	std::ifstream stream(cachePath, std::ios::binary);
+	ProgramCacheHeader header;
+	if (!stream || !stream.read((char*)&header, sizeof(header)) || memcmp(header.Magic, s_Magic, 4) != 0 ||
+		header.Version != FormatVersion || header.Key != key)
+	{
+		m_Stats.Misses++;
+		return 0;
+	}
+
+	std::vector<char> binary(header.BinarySize);
+	if (!stream.read(binary.data(), binary.size()))
+	{
+		m_Stats.Misses++;
+		return 0;
+	}
+
+	GLCall(unsigned int program = glCreateProgram());
+	GLCall(glProgramBinary(program, header.BinaryFormat, binary.data(), (GLsizei)binary.size()));
+
+	//a driver may refuse its own binaries, e.g. after a change it doesn't put in the version string
+	int linked = GL_FALSE;
+	GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+	if (linked == GL_FALSE)
+	{
+		GLCall(glDeleteProgram(program));
+		stream.close();
+		remove(cachePath.c_str());
+		m_Stats.Rejected++;
+		m_Stats.Misses++;
+		return 0;
+	}
+
+	m_Stats.Hits++;
+	return program;
+}
+
+void ProgramCache::PrepareProgram(unsigned int program) const
+{
+	if (IsEnabled())
+	{
+		GLCall(glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+	}
+}
+
+void ProgramCache::Store(const ShaderSource& source, unsigned int program)
+{
+	if (!IsEnabled())
+		return;
+
+	int linked = GL_FALSE, length = 0;
+	GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+	GLCall(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+	if (linked == GL_FALSE || length <= 0)
+		return;
+
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	GLCall(glGetProgramBinary(program, length, &length, &format, binary.data()));
+
+	ProgramCacheHeader header;
+	memcpy(header.Magic, s_Magic, 4);
+	header.Version = FormatVersion;
+	header.Key = GetKey(source);
+	header.BinaryFormat = format;
+	header.BinarySize = (unsigned int)length;
+
+	std::string cachePath = GetCachePath(header.Key);
+	bool stored = FileSystem::WriteFileAtomic(cachePath, [&](std::ostream& stream)
+	{
+		stream.write((const char*)&header, sizeof(header));
+		stream.write(binary.data(), length);
+	});
+	if (stored)
+	{
+		m_Stats.Stored++;
+		Trim(cachePath);
+	}
+}
+
+void ProgramCache::Trim(const std::string& keepPath)
+{
+	struct Entry
+	{
+		std::string Path;
+		unsigned long long ModifiedTime;
+		unsigned long long Size;
+	};
+
+	std::vector<Entry> entries;
+	unsigned long long totalSize = 0;
+	for (const std::string& path : FileSystem::ListFiles(m_Directory, ".progbin"))
+	{
+		Entry entry = { path, 0, 0 };
+		if (!FileSystem::GetFileInfo(path, entry.ModifiedTime, entry.Size))
+			continue;
+		totalSize += entry.Size;
+		entries.push_back(entry);
+	}
+	if (entries.size() <= MaxEntries && totalSize <= MaxSize)
+		return;
+
+	//a hit doesn't touch its file, so this is oldest written rather than least used. good enough for
+	//a cache that mostly fills up with the stale versions of shaders being edited
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.ModifiedTime < b.ModifiedTime; });
+	size_t count = entries.size();
+	for (const Entry& entry : entries)
+	{
+		if (count <= MaxEntries && totalSize <= MaxSize)
+			break;
+		if (entry.Path == keepPath || remove(entry.Path.c_str()) != 0)
+			continue;
+		count--;
+		totalSize -= entry.Size;
+		m_Stats.Trimmed++;
+	}
+}
\ No newline at end of file
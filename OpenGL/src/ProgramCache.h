@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+struct ShaderSource;
+
+//on-disk cache of linked program binaries (ARB_get_program_binary). an entry is keyed by the hash of
+//the shader sources and of the vendor, renderer and version strings, so a driver update or another
+//GPU never sees binaries it didn't produce. drivers may still refuse a binary, the shader then
+//compiles from source and the entry is replaced.
+class ProgramCache
+{
+public:
+	//bumped whenever the layout of a cache file changes
+	static const unsigned int FormatVersion = 1;
+	//every edit of a shader leaves a new entry behind, the oldest go once the directory outgrows these
+	static const unsigned int MaxEntries = 256;
+	static const unsigned long long MaxSize = 64ull * 1024 * 1024;
+
+	struct Stats
+	{
+		unsigned int Hits = 0;
+		unsigned int Misses = 0;
+		//binaries the driver refused to load
+		unsigned int Rejected = 0;
+		unsigned int Stored = 0;
+		//entries removed to keep the directory within its limits
+		unsigned int Trimmed = 0;
+	};
+private:
+	static std::unique_ptr<ProgramCache> s_Instance;
+
+	std::string m_Directory;
+	//hash of the driver strings, computed once the context exists
+	unsigned long long m_DriverHash;
+	bool m_Supported;
+	bool m_Enabled;
+	Stats m_Stats;
+public:
+	ProgramCache(const std::string& directory = "cache/shaders");
+
+	//process wide cache, created on first use. needs a current context
+	static ProgramCache& Get();
+	static void Shutdown();
+
+	//linked program for "source", 0 when there is no usable entry
+	unsigned int Load(const ShaderSource& source);
+	//write the binary of a successfully linked "program", which was linked after PrepareProgram()
+	void Store(const ShaderSource& source, unsigned int program);
+	//call before linking a program that will be stored
+	void PrepareProgram(unsigned int program) const;
+
+	//the driver exposes program binaries in at least one format
+	inline bool IsSupported() const { return m_Supported; }
+	inline void SetEnabled(bool enabled) { m_Enabled = enabled; }
+	inline bool IsEnabled() const { return m_Enabled && m_Supported; }
+
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline void ResetStats() { m_Stats = Stats(); }
+private:
+	std::string GetCachePath(unsigned long long key) const;
+	unsigned long long GetKey(const ShaderSource& source) const;
+	//remove the least recently written entries until the directory is within MaxEntries and MaxSize
+	void Trim(const std::string& keepPath);
+};
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "QuadIndexBuffer.h"
+
+#include "Renderer.h"
+
+#include <vector>
+
+std::unique_ptr<IndexBuffer> QuadIndexBuffer::s_ShortBuffer;
+std::unique_ptr<IndexBuffer> QuadIndexBuffer::s_IntBuffer;
+unsigned int QuadIndexBuffer::s_ShortQuadCount = 0;
+unsigned int QuadIndexBuffer::s_IntQuadCount = 0;
+
+template<typename T>
+static std::vector<T> BuildQuadIndices(unsigned int quadCount)
+{
+	std::vector<T> indices(quadCount * 6);
+	unsigned int offset = 0;
+	for (size_t i = 0; i < indices.size(); i += 6)
+	{
+		indices[i + 0] = (T)(0 + offset);
+		indices[i + 1] = (T)(1 + offset);
+		indices[i + 2] = (T)(2 + offset);
+
+		indices[i + 3] = (T)(2 + offset);
+		indices[i + 4] = (T)(3 + offset);
+		indices[i + 5] = (T)(0 + offset);
+
+		offset += 4;
+	}
+	return indices;
+}
+
+unsigned int QuadIndexBuffer::GrowCapacity(unsigned int current, unsigned int quadCount, unsigned int limit)
+{
+	unsigned int capacity = current ? current : (unsigned int)MinQuadCount;
+	while (capacity < quadCount)
+		capacity *= 2;
+	return capacity < limit ? capacity : limit;
+}
+
+const IndexBuffer& QuadIndexBuffer::Get(unsigned int quadCount)
+{
+	if (quadCount <= MaxShortQuadCount)
+	{
+		if (quadCount > s_ShortQuadCount || !s_ShortBuffer)
+		{
+			s_ShortQuadCount = GrowCapacity(s_ShortQuadCount, quadCount, MaxShortQuadCount);
+			std::vector<unsigned short> indices = BuildQuadIndices<unsigned short>(s_ShortQuadCount);
+
+			if (s_ShortBuffer)
+				s_ShortBuffer->SetData(indices.data(), (unsigned int)indices.size());
+			else
+				s_ShortBuffer = std::make_unique<IndexBuffer>(indices.data(), (unsigned int)indices.size());
+		}
+		return *s_ShortBuffer;
+	}
+
+	if (quadCount > s_IntQuadCount || !s_IntBuffer)
+	{
+		//the 16 bit buffer already covers everything up to MaxShortQuadCount, start above it
+		unsigned int current = s_IntQuadCount ? s_IntQuadCount : (unsigned int)MaxShortQuadCount;
+		s_IntQuadCount = GrowCapacity(current, quadCount, 0xffffffff / 6);
+		std::vector<unsigned int> indices = BuildQuadIndices<unsigned int>(s_IntQuadCount);
+
+		if (s_IntBuffer)
+			s_IntBuffer->SetData(indices.data(), (unsigned int)indices.size());
+		else
+			s_IntBuffer = std::make_unique<IndexBuffer>(indices.data(), (unsigned int)indices.size());
+	}
+	return *s_IntBuffer;
+}
+
+void QuadIndexBuffer::Shutdown()
+{
+	s_ShortBuffer.reset();
+	s_IntBuffer.reset();
+	s_ShortQuadCount = 0;
+	s_IntQuadCount = 0;
+}
\ No newline at end of file
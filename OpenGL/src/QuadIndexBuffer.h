@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+
+#include "IndexBuffer.h"
+
+//process wide index buffers holding the 0-1-2-2-3-0 pattern for consecutive quads.
+//the pattern is built once and grown geometrically, so quad renderers never fill their own.
+class QuadIndexBuffer
+{
+public:
+	//quads addressable with 16 bit indices (65536 vertices)
+	static const unsigned int MaxShortQuadCount = 65536 / 4;
+	static const unsigned int MinQuadCount = 64;
+private:
+	static std::unique_ptr<IndexBuffer> s_ShortBuffer;
+	static std::unique_ptr<IndexBuffer> s_IntBuffer;
+	static unsigned int s_ShortQuadCount;
+	static unsigned int s_IntQuadCount;
+public:
+	//index buffer with room for at least "quadCount" quads, GL_UNSIGNED_SHORT whenever they fit.
+	//the reference stays valid when the buffer grows.
+	static const IndexBuffer& Get(unsigned int quadCount);
+
+	//release the GL buffers, must be called while the context is still current
+	static void Shutdown();
+private:
+	static unsigned int GrowCapacity(unsigned int current, unsigned int quadCount, unsigned int limit);
+};
\ No newline at end of file
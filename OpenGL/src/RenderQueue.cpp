@@ -0,0 +1,108 @@
+#include "RenderQueue.h"
+
+#include <chrono>
+
+uint64_t SortKey::Make(unsigned int layer, bool translucent, unsigned int shaderID, unsigned int textureSetID, float depth)
+{
+	depth = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+	uint64_t maxDepth = (1ull << DepthBits) - 1;
+	uint64_t quantized = (uint64_t)(depth * maxDepth);
+
+	uint64_t key = (uint64_t)(layer & ((1u << LayerBits) - 1)) << 60;
+	uint64_t shader = shaderID & ((1u << ShaderBits) - 1);
+	uint64_t textures = textureSetID & ((1u << TextureSetBits) - 1);
+	if (translucent)
+	{
+		//back to front: the farthest draw gets the smallest key
+		key |= 1ull << 59;
+		key |= (maxDepth - quantized) << 28;
+		key |= shader << 16;
+		key |= textures;
+	}
+	else
+	{
+		key |= shader << 47;
+		key |= textures << 31;
+		key |= quantized;
+	}
+	return key;
+}
+
+RenderQueue::RenderQueue()
+	:m_Sorted(false)
+{
+}
+
+void RenderQueue::Clear()
+{
+	m_Packets.clear();
+	m_Entries.clear();
+	m_Sorted = false;
+}
+
+void RenderQueue::Push(const DrawPacket& packet)
+{
+	m_Entries.push_back({ packet.Key, (unsigned int)m_Packets.size() });
+	m_Packets.push_back(packet);
+	m_Sorted = false;
+}
+
+void RenderQueue::Sort()
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	if (!m_Sorted)
+		RadixSort(m_Entries, m_Scratch);
+	m_Sorted = true;
+
+	m_Stats.SortTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	m_Stats.Packets = GetSize();
+}
+
+void RenderQueue::RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch)
+{
+	const size_t count = entries.size();
+	if (count < 2)
+		return;
+	scratch.resize(count);
+
+	//histograms of all 8 digits in one pass over the keys
+	unsigned int histograms[8][256] = {};
+	for (const SortEntry& entry : entries)
+	{
+		uint64_t key = entry.Key;
+		for (int pass = 0; pass < 8; pass++)
+			histograms[pass][(key >> (pass * 8)) & 0xff]++;
+	}
+
+	SortEntry* src = entries.data();
+	SortEntry* dst = scratch.data();
+	for (int pass = 0; pass < 8; pass++)
+	{
+		unsigned int* histogram = histograms[pass];
+
+		//every key has the same digit, this pass would not move anything
+		unsigned int first = (unsigned int)((src[0].Key >> (pass * 8)) & 0xff);
+		if (histogram[first] == count)
+			continue;
+
+		unsigned int offsets[256];
+		unsigned int sum = 0;
+		for (int i = 0; i < 256; i++)
+		{
+			offsets[i] = sum;
+			sum += histogram[i];
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			unsigned int digit = (unsigned int)((src[i].Key >> (pass * 8)) & 0xff);
+			dst[offsets[digit]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+
+	//an odd number of passes left the result in the scratch buffer
+	if (src != entries.data())
+		entries.swap(scratch);
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Renderer.h"
+
+class VertexArray;
+class IndexBuffer;
+class Shader;
+class Texture;
+
+//64 bit sort key, most significant bits first:
+//  layer(4) | translucent(1) | opaque:      shader(12) | texture set(16) | depth(31, front to back)
+//                            | translucent: depth(31, back to front) | shader(12) | texture set(16)
+//opaque draws are grouped by state, translucent draws keep the order blending needs.
+class SortKey
+{
+public:
+	static const unsigned int LayerBits = 4;
+	static const unsigned int ShaderBits = 12;
+	static const unsigned int TextureSetBits = 16;
+	static const unsigned int DepthBits = 31;
+
+	//"depth" is the normalized view depth in [0, 1], 0 is closest to the camera
+	static uint64_t Make(unsigned int layer, bool translucent, unsigned int shaderID, unsigned int textureSetID, float depth);
+};
+
+struct DrawPacket
+{
+	static const unsigned int MaxTextures = 4;
+
+	uint64_t Key;
+	const VertexArray* VAO;
+	const IndexBuffer* IB;
+	Shader* Program;
+	const Texture* Textures[MaxTextures];
+	DrawRange Range;
+	glm::mat4 Transform;
+};
+
+//collects draw packets for a frame and orders them by key with a LSD radix sort
+class RenderQueue
+{
+public:
+	struct SortEntry
+	{
+		uint64_t Key;
+		unsigned int Index;
+	};
+
+	struct Stats
+	{
+		unsigned int Packets = 0;
+		//shader, vertex array and texture changes when dispatched in sorted order
+		unsigned int StateChanges = 0;
+		//the same count for dispatching in submission order
+		unsigned int UnsortedStateChanges = 0;
+		float SortTime = 0.0f;//ms
+	};
+private:
+	std::vector<DrawPacket> m_Packets;
+	std::vector<SortEntry> m_Entries;
+	//ping-pong buffer of the radix sort, kept to avoid allocating every frame
+	std::vector<SortEntry> m_Scratch;
+	bool m_Sorted;
+	Stats m_Stats;
+public:
+	RenderQueue();
+
+	void Clear();
+	void Push(const DrawPacket& packet);
+	void Sort();
+
+	inline unsigned int GetSize() const { return (unsigned int)m_Packets.size(); }
+	//i-th packet in sorted order, valid after Sort()
+	inline const DrawPacket& GetSorted(unsigned int i) const { return m_Packets[m_Entries[i].Index]; }
+	inline const DrawPacket& GetSubmitted(unsigned int i) const { return m_Packets[i]; }
+
+	inline Stats& GetStats() { return m_Stats; }
+	inline const Stats& GetStats() const { return m_Stats; }
+
+	//counts state changes needed to draw "count" packets in the order given by "at"
+	template<typename F>
+	static unsigned int CountStateChanges(unsigned int count, F at);
+
+	//stable sort by key, "scratch" is resized to the size of "entries"
+	static void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+};
+
+template<typename F>
+unsigned int RenderQueue::CountStateChanges(unsigned int count, F at)
+{
+	unsigned int changes = 0;
+	const DrawPacket* last = nullptr;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		const DrawPacket& packet = at(i);
+		if (!last || last->Program != packet.Program)
+			changes++;
+		if (!last || last->VAO != packet.VAO)
+			changes++;
+		for (unsigned int t = 0; t < DrawPacket::MaxTextures; t++)
+		{
+			if (packet.Textures[t] && (!last || last->Textures[t] != packet.Textures[t]))
+				changes++;
+		}
+		last = &packet;
+	}
+	return changes;
+}
\ No newline at end of file
@@ -5,6 +5,11 @@
 #include "IndexBuffer.h"
 #include "VertexArray.h"
 #include "Shader.h"
+#include "Texture.h"
+#include "RenderQueue.h"
+#include "DrawCommandBuffer.h"
+#include "GLStateCache.h"
+#include "CameraBuffer.h"
 
 void GLClearError()
 {
@@ -20,15 +25,194 @@ bool GLLogCall(const char* function, const char* file, int line)
     return true;
 }
 
+Renderer::Renderer()
+{
+}
+
+Renderer::~Renderer()
+{
+}
+
 void Renderer::Clear() const
 {
     GLCall(glClear(GL_COLOR_BUFFER_BIT));
 }
 
+void Renderer::SetBlendMode(BlendMode mode) const
+{
+    switch (mode)
+    {
+    case BlendMode::Alpha:
+        GLStateCache::Get().SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    case BlendMode::Premultiplied:
+        GLStateCache::Get().SetBlend(true, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    case BlendMode::Additive:
+        GLStateCache::Get().SetBlend(true, GL_SRC_ALPHA, GL_ONE);
+        break;
+    default:
+        GLStateCache::Get().SetBlend(false, GL_ONE, GL_ZERO);
+        break;
+    }
+}
+
 void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const
 {
+    Draw(va, ib, shader, { 0, ib.GetCount(), 0 });
+}
+
+void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const DrawRange& range) const
+{
+    ASSERT(range.First + range.Count <= ib.GetCount());
+
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+
+    //the index buffer offset is given in bytes
+    const void* offset = (const void*)((size_t)range.First * ib.GetElementSize());
+    if (range.BaseVertex == 0)
+    {
+        GLCall(glDrawElements(ib.GetMode(), range.Count, ib.GetType(), offset));
+    }
+    else
+    {
+        GLCall(glDrawElementsBaseVertex(ib.GetMode(), range.Count, ib.GetType(), (void*)offset, range.BaseVertex));
+    }
+}
+
+void Renderer::DrawInstanced(const VertexArray& va, const Shader& shader, unsigned int vertexCount, unsigned int instanceCount) const
+{
+    shader.Bind();
+    va.Bind();
+    GLCall(glDrawArraysInstanced(GL_TRIANGLES, 0, vertexCount, instanceCount));
+}
+
+void Renderer::DrawElementsInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const
+{
+    DrawElementsInstanced(va, ib, shader, instanceCount, { 0, ib.GetCount(), 0 });
+}
+
+void Renderer::DrawElementsInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, const DrawRange& range) const
+{
+    ASSERT(range.First + range.Count <= ib.GetCount());
+
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+
+    const void* offset = (const void*)((size_t)range.First * ib.GetElementSize());
+    if (range.BaseVertex == 0)
+    {
+        GLCall(glDrawElementsInstanced(ib.GetMode(), range.Count, ib.GetType(), offset, instanceCount));
+    }
+    else
+    {
+        GLCall(glDrawElementsInstancedBaseVertex(ib.GetMode(), range.Count, ib.GetType(), offset, instanceCount, range.BaseVertex));
+    }
+}
+
+void Renderer::DrawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, DrawCommandBuffer& commands) const
+{
+    if (commands.GetCount() == 0)
+        return;
+
     shader.Bind();
     va.Bind();
     ib.Bind();
-    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
+
+    if (DrawCommandBuffer::IsSupported())
+    {
+        commands.Upload();
+        commands.Bind();
+        GLCall(glMultiDrawElementsIndirect(ib.GetMode(), ib.GetType(), nullptr, commands.GetCount(), 0));
+        return;
+    }
+
+    //without ARB_base_instance the instanced attributes are moved to the base instance by hand
+    unsigned int baseInstance = 0;
+    for (const DrawElementsIndirectCommand& command : commands.GetCommands())
+    {
+        const void* offset = (const void*)((size_t)command.FirstIndex * ib.GetElementSize());
+        if (command.BaseInstance != 0 && GLEW_ARB_base_instance)
+        {
+            GLCall(glDrawElementsInstancedBaseVertexBaseInstance(ib.GetMode(), command.Count, ib.GetType(), offset,
+                command.InstanceCount, command.BaseVertex, command.BaseInstance));
+            continue;
+        }
+
+        if (command.BaseInstance != baseInstance && va.HasInstanceAttribs())
+        {
+            va.SetBaseInstance(command.BaseInstance);
+            baseInstance = command.BaseInstance;
+        }
+        if (command.InstanceCount == 1)
+        {
+            GLCall(glDrawElementsBaseVertex(ib.GetMode(), command.Count, ib.GetType(), (void*)offset, command.BaseVertex));
+        }
+        else
+        {
+            GLCall(glDrawElementsInstancedBaseVertex(ib.GetMode(), command.Count, ib.GetType(), offset,
+                command.InstanceCount, command.BaseVertex));
+        }
+    }
+    if (baseInstance != 0)
+        va.SetBaseInstance(0);
+}
+
+void Renderer::BeginScene(const glm::mat4& viewProjection)
+{
+    if (!m_Queue)
+        m_Queue = std::make_unique<RenderQueue>();
+
+    //shared by every program of the scene through the Camera block
+    CameraBuffer::SetViewProjection(viewProjection);
+    m_Queue->Clear();
+}
+
+void Renderer::Submit(const VertexArray& va, const IndexBuffer& ib, Shader& shader, const glm::mat4& transform, uint64_t sortKey, const Texture* texture)
+{
+    DrawPacket packet = {};
+    packet.Key = sortKey;
+    packet.VAO = &va;
+    packet.IB = &ib;
+    packet.Program = &shader;
+    packet.Textures[0] = texture;
+    packet.Range = { 0, ib.GetCount(), 0 };
+    packet.Transform = transform;
+    Submit(packet);
+}
+
+void Renderer::Submit(const DrawPacket& packet)
+{
+    ASSERT(m_Queue);
+    m_Queue->Push(packet);
+}
+
+void Renderer::EndScene()
+{
+    RenderQueue& queue = *m_Queue;
+    queue.Sort();
+
+    unsigned int count = queue.GetSize();
+    RenderQueue::Stats& stats = queue.GetStats();
+    stats.StateChanges = RenderQueue::CountStateChanges(count, [&queue](unsigned int i) -> const DrawPacket& { return queue.GetSorted(i); });
+    stats.UnsortedStateChanges = RenderQueue::CountStateChanges(count, [&queue](unsigned int i) -> const DrawPacket& { return queue.GetSubmitted(i); });
+
+    //binds that match the previous packet are dropped by the state cache
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const DrawPacket& packet = queue.GetSorted(i);
+        for (unsigned int t = 0; t < DrawPacket::MaxTextures; t++)
+        {
+            if (packet.Textures[t])
+                packet.Textures[t]->Bind(t);
+        }
+
+        packet.Program->Bind();
+        packet.Program->SetUniformMat4f("u_Model", packet.Transform);
+        Draw(*packet.VAO, *packet.IB, *packet.Program, packet.Range);
+    }
+    queue.Clear();
 }
@@ -3,6 +3,11 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+#include <cstdint>
+#include <memory>
+
+#include "glm/glm.hpp"
+
 #define ASSERT(x) if (!(x)) __debugbreak();
 #ifdef _DEBUG
 #define GLCall(x) GLClearError();\
@@ -18,11 +23,68 @@ bool GLLogCall(const char* function, const char* file, int line);
 class Shader;
 class IndexBuffer;
 class VertexArray;
+class Texture;
+class RenderQueue;
+struct DrawPacket;
+class DrawCommandBuffer;
+
+//a sub range of an index buffer, lets one large index buffer serve many draws
+struct DrawRange
+{
+    //first index to read from the index buffer
+    unsigned int First = 0;
+    //number of indices to draw
+    unsigned int Count = 0;
+    //added to every index before the vertex is fetched
+    int BaseVertex = 0;
+};
+
+//how fragments are combined with the framebuffer
+enum class BlendMode
+{
+    //overwrite
+    None,
+    //straight alpha: src * a + dst * (1 - a)
+    Alpha,
+    //color already multiplied by alpha: src + dst * (1 - a). a color with alpha 0 adds,
+    //so translucent and additive sprites can share one batch and one state
+    Premultiplied,
+    //src * a + dst
+    Additive
+};
 
 class Renderer
 {
 private:
+    //created by the first BeginScene, immediate drawing doesn't need it
+    std::unique_ptr<RenderQueue> m_Queue;
 public:
+    Renderer();
+    ~Renderer();
+
     void Clear() const;
+    //set through the GLStateCache, setting the current mode again costs no GL call
+    void SetBlendMode(BlendMode mode) const;
     void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+    void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const DrawRange& range) const;
+
+    //instanced drawing, per instance attributes are set up with an instance step rate in the layout
+    void DrawInstanced(const VertexArray& va, const Shader& shader, unsigned int vertexCount, unsigned int instanceCount) const;
+    void DrawElementsInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const;
+    void DrawElementsInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount, const DrawRange& range) const;
+
+    //every command of the buffer in one glMultiDrawElementsIndirect call,
+    //or one glDrawElements*BaseVertex per command when the context lacks multi draw indirect
+    void DrawIndirect(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, DrawCommandBuffer& commands) const;
+
+    //queued drawing: submitted packets are sorted by their key in EndScene and then drawn,
+    //so draws sharing state end up next to each other. viewProjection goes to the Camera block,
+    //the transform of each packet to "u_Model".
+    void BeginScene(const glm::mat4& viewProjection);
+    void Submit(const VertexArray& va, const IndexBuffer& ib, Shader& shader, const glm::mat4& transform, uint64_t sortKey, const Texture* texture = nullptr);
+    void Submit(const DrawPacket& packet);
+    void EndScene();
+
+    //queue of the last scene, nullptr before the first BeginScene
+    inline const RenderQueue* GetQueue() const { return m_Queue.get(); }
 };
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "Sampler.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+std::unordered_map<unsigned int, unsigned int> SamplerCache::s_Samplers;
+float SamplerCache::s_MaxAnisotropy = 0.0f;
+
+unsigned int SamplerCache::MakeKey(const SamplerDesc& desc, int anisotropy)
+{
+	return (unsigned int)desc.Filter | ((unsigned int)desc.Wrap << 2) | ((unsigned int)anisotropy << 4);
+}
+
+float SamplerCache::GetMaxAnisotropy()
+{
+	if (s_MaxAnisotropy == 0.0f)
+	{
+		s_MaxAnisotropy = 1.0f;
+		if (GLEW_EXT_texture_filter_anisotropic)
+		{
+			GLCall(glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &s_MaxAnisotropy));
+		}
+	}
+	return s_MaxAnisotropy;
+}
+
+int SamplerCache::QuantizeAnisotropy(float anisotropy)
+{
+	float maxAnisotropy = GetMaxAnisotropy();
+	return (int)(anisotropy < 1.0f ? 1.0f : (anisotropy > maxAnisotropy ? maxAnisotropy : anisotropy));
+}
+
+unsigned int SamplerCache::Get(const SamplerDesc& desc)
+{
+	int anisotropy = QuantizeAnisotropy(desc.Anisotropy);
+	unsigned int key = MakeKey(desc, anisotropy);
+
+	auto it = s_Samplers.find(key);
+	if (it != s_Samplers.end())
+		return it->second;
+
+	unsigned int sampler;
+	GLCall(glGenSamplers(1, &sampler));
+
+	GLint minFilter = GL_NEAREST, magFilter = GL_NEAREST;
+	if (desc.Filter == TextureFilter::Linear)
+	{
+		minFilter = GL_LINEAR;
+		magFilter = GL_LINEAR;
+	}
+	else if (desc.Filter == TextureFilter::Trilinear)
+	{
+		minFilter = GL_LINEAR_MIPMAP_LINEAR;
+		magFilter = GL_LINEAR;
+	}
+	GLCall(glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, minFilter));
+	GLCall(glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, magFilter));
+
+	GLint wrap = GL_CLAMP_TO_EDGE;
+	if (desc.Wrap == TextureWrap::Repeat)
+		wrap = GL_REPEAT;
+	else if (desc.Wrap == TextureWrap::MirroredRepeat)
+		wrap = GL_MIRRORED_REPEAT;
+	GLCall(glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, wrap));
+	GLCall(glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, wrap));
+
+	if (GetMaxAnisotropy() > 1.0f)
+	{
+		GLCall(glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT, (float)anisotropy));
+	}
+
+	s_Samplers[key] = sampler;
+	return sampler;
+}
+
+void SamplerCache::Shutdown()
+{
+	for (auto& sampler : s_Samplers)
+	{
+		GLStateCache::Get().OnDeleteSampler(sampler.second);
+		GLCall(glDeleteSamplers(1, &sampler.second));
+	}
+	s_Samplers.clear();
+	s_MaxAnisotropy = 0.0f;
+}
\ No newline at end of file
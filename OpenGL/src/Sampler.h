@@ -0,0 +1,55 @@
+#pragma once
+
+#include <unordered_map>
+
+enum class TextureFilter
+{
+	Nearest = 0,
+	//bilinear within the base level, ignores mip levels
+	Linear,
+	//bilinear within and linear between mip levels
+	Trilinear
+};
+
+enum class TextureWrap
+{
+	Clamp = 0,
+	Repeat,
+	MirroredRepeat
+};
+
+struct SamplerDesc
+{
+	TextureFilter Filter = TextureFilter::Trilinear;
+	TextureWrap Wrap = TextureWrap::Clamp;
+	//1 disables anisotropic filtering, clamped to what the driver supports
+	float Anisotropy = 1.0f;
+
+	SamplerDesc() {}
+	SamplerDesc(TextureFilter filter, TextureWrap wrap = TextureWrap::Clamp, float anisotropy = 1.0f)
+		:Filter(filter), Wrap(wrap), Anisotropy(anisotropy) {}
+};
+
+//sampler objects shared by every texture that samples the same way, so changing filtering
+//never touches texture state and the number of distinct samplers stays tiny.
+class SamplerCache
+{
+private:
+	static std::unordered_map<unsigned int, unsigned int> s_Samplers;
+	//0 until queried, 1 without EXT_texture_filter_anisotropic
+	static float s_MaxAnisotropy;
+public:
+	//sampler object for "desc", created on first use
+	static unsigned int Get(const SamplerDesc& desc);
+
+	static float GetMaxAnisotropy();
+	//anisotropy a sampler for "anisotropy" really gets: clamped to what the driver supports and
+	//cut to whole steps, the hardware only distinguishes a few levels anyway
+	static int QuantizeAnisotropy(float anisotropy);
+	inline static unsigned int GetSamplerCount() { return (unsigned int)s_Samplers.size(); }
+
+	//delete the sampler objects, must be called while the context is still current
+	static void Shutdown();
+private:
+	static unsigned int MakeKey(const SamplerDesc& desc, int anisotropy);
+};
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "Shader.h"
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "UniformBuffer.h"
+#include "ProgramCache.h"
+#include "ShaderReloader.h"
 
 #include <iostream>
 
@@ -8,16 +12,40 @@
 
 #include "glm/gtc/matrix_transform.hpp"
 
-Shader::Shader(const std::string& filePath)
-	:m_FilePath(filePath)
+Shader::Shader(const std::string& filePath, bool wait)
+	:m_RendererID(0), m_FilePath(filePath)
 {
-	ShaderSource source = ParseShader(filePath);
+	Create(ParseShader(filePath), wait);
+	ShaderReloader::Get().Register(this);
+}
+
+Shader::Shader(const ShaderSource& source, bool wait)
+	:m_RendererID(0)
+{
+	Create(source, wait);
+}
+
+void Shader::Create(const ShaderSource& source, bool wait)
+{
+	//a binary from an earlier run skips compiling and linking
+	m_RendererID = ProgramCache::Get().Load(source);
+	if (m_RendererID)
+	{
+		Reflect();
+		return;
+	}
 
-	m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+	StartCompile(source);
+	if (wait)
+		PollCompile(true);
 }
 
 Shader::~Shader()
 {
+	if (!m_FilePath.empty())
+		ShaderReloader::Unregister(this);
+	DeletePending();
+	GLStateCache::Get().OnDeleteProgram(m_RendererID);
 	GLCall(glDeleteProgram(m_RendererID));
 }
 
@@ -55,98 +83,362 @@ ShaderSource Shader::ParseShader(const std::string& filePath)
 	return  { ss[0].str(), ss[1].str() };
 }
 
-unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
+void Shader::Bind() const
 {
-	unsigned int id = glCreateShader(type);
-	const char* src = source.c_str();
-	glShaderSource(id, 1, &src, nullptr);
-	glCompileShader(id);
+	GLStateCache::Get().UseProgram(m_RendererID);
+}
 
-	int result;
-	glGetShaderiv(id, GL_COMPILE_STATUS, &result);
-	if (result == GL_FALSE)
+void Shader::UnBind() const
+{
+	GLStateCache::Get().UseProgram(0);
+}
+
+void Shader::SetUniform1i(UniformHandle uniform, int value)
+{
+	int location = GetUniformLocation(uniform);
+	if (location != -1)
 	{
-		int length;
-		glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
+		GLCall(glUniform1i(location, value));
+	}
+}
 
-		char* message = (char*)alloca(length * sizeof(char));
-		glGetShaderInfoLog(id, length, &length, message);
+void Shader::SetUniform4f(UniformHandle uniform, float v0, float v1, float v2, float v3)
+{
+	int location = GetUniformLocation(uniform);
+	if (location != -1)
+	{
+		GLCall(glUniform4f(location, v0, v1, v2, v3));
+	}
+}
 
-		std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment:") << " shader!" << std::endl;
-		std::cout << message << std::endl;
-		glDeleteShader(id);
-		return 0;
+void Shader::SetUniform1f(UniformHandle uniform, float value)
+{
+	int location = GetUniformLocation(uniform);
+	if (location != -1)
+	{
+		GLCall(glUniform1f(location, value));
 	}
+}
 
-	return id;
+void Shader::SetUniformMat4f(UniformHandle uniform, const glm::mat4& matrix)
+{
+	int location = GetUniformLocation(uniform);
+	if (location != -1)
+	{
+		GLCall(glUniformMatrix4fv(location, 1, GL_FALSE, &matrix[0][0]));
+	}
 }
 
-unsigned int Shader::CreateShader(const std::string& vertexShader, const std::string& fragmentShader)
+void Shader::SetUniformArrayi(UniformHandle uniform, const int* values, unsigned int count)
 {
-	unsigned int program = glCreateProgram();
-	unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-	unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+	int location = GetUniformLocation(uniform);
+	if (location != -1)
+	{
+		GLCall(glUniform1iv(location, count, values));
+	}
+}
 
-	glAttachShader(program, vs);
-	glAttachShader(program, fs);
+void Shader::SetUniform1i(const std::string& name, int value)
+{
+	SetUniform1i(GetUniform(name), value);
+}
 
-	glLinkProgram(program);
-	glValidateProgram(program);
+void Shader::SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3)
+{
+	SetUniform4f(GetUniform(name), v0, v1, v2, v3);
+}
 
-	glDeleteShader(vs);
-	glDeleteShader(fs);
+void Shader::SetUniform1f(const std::string& name, float value)
+{
+	SetUniform1f(GetUniform(name), value);
+}
 
-	return program;
+void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix)
+{
+	SetUniformMat4f(GetUniform(name), matrix);
 }
 
-void Shader::Bind() const
+void Shader::SetUniformArrayi(const std::string& name, const int* values, unsigned int count)
 {
-	GLCall(glUseProgram(m_RendererID));
+	SetUniformArrayi(GetUniform(name), values, count);
 }
 
-void Shader::UnBind() const
+UniformHandle Shader::GetUniform(const std::string& name) const
 {
-	GLCall(glUseProgram(0));
+	UniformHandle handle;
+	auto it = m_UniformIndices.find(name);
+	if (it != m_UniformIndices.end())
+	{
+		handle.Index = it->second;
+		return handle;
+	}
+
+	//not reflected: array elements and struct members by full name, or a uniform the program lacks
+	UniformInfo uniform;
+	uniform.Name = name;
+	if (m_RendererID)
+	{
+		GLCall(uniform.Location = glGetUniformLocation(m_RendererID, name.c_str()));
+		if (uniform.Location == -1)
+			std::cout << "Warning: uniform " << name << " doesn't exist!" << std::endl;
+	}
+
+	handle.Index = (int)m_Uniforms.size();
+	m_Uniforms.push_back(uniform);
+	m_UniformIndices[name] = handle.Index;
+	return handle;
 }
 
-void Shader::SetUniform1i(const std::string& name, int value)
+void Shader::Reflect()
 {
-	GLCall(glUniform1i(GetUniformLocation(name), value));
+	//a rebuilt program keeps the handles given out so far, only their locations change
+	for (UniformInfo& uniform : m_Uniforms)
+	{
+		GLCall(uniform.Location = glGetUniformLocation(m_RendererID, uniform.Name.c_str()));
+	}
+
+	int count = 0;
+	GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &count));
+	char name[256];
+	for (int index = 0; index < count; index++)
+	{
+		int length = 0, size = 0;
+		GLenum type = 0;
+		GLCall(glGetActiveUniform(m_RendererID, index, sizeof(name), &length, &size, &type, name));
+
+		//members of uniform blocks have no location
+		GLCall(int location = glGetUniformLocation(m_RendererID, name));
+		if (location == -1)
+			continue;
+
+		//arrays are listed as "name[0]", they are set by their plain name
+		std::string base(name, length);
+		if (base.size() > 3 && base.compare(base.size() - 3, 3, "[0]") == 0)
+			base.resize(base.size() - 3);
+
+		auto it = m_UniformIndices.find(base);
+		int uniformIndex = 0;
+		if (it != m_UniformIndices.end())
+		{
+			uniformIndex = it->second;
+		}
+		else
+		{
+			uniformIndex = (int)m_Uniforms.size();
+			m_Uniforms.push_back(UniformInfo());
+			m_Uniforms.back().Name = base;
+			m_UniformIndices[base] = uniformIndex;
+		}
+
+		UniformInfo& uniform = m_Uniforms[uniformIndex];
+		uniform.Location = location;
+		uniform.Type = type;
+		uniform.Count = size;
+	}
+
+	//a block goes to the binding point of its name, so a UniformBuffer for "Camera" feeds every program declaring it
+	int blocks = 0;
+	GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_BLOCKS, &blocks));
+	for (int block = 0; block < blocks; block++)
+	{
+		int length = 0;
+		GLCall(glGetActiveUniformBlockName(m_RendererID, block, sizeof(name), &length, name));
+		GLCall(glUniformBlockBinding(m_RendererID, block, UniformBuffer::GetBindingPoint(std::string(name, length))));
+	}
 }
 
-void Shader::SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3)
+void Shader::StartCompile(const ShaderSource& source)
 {
-	GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3));
+	//a newer edit replaces a compile still in flight
+	DeletePending();
+
+	m_Pending.Source = source;
+	m_Pending.VertexShader = glCreateShader(GL_VERTEX_SHADER);
+	m_Pending.FragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+	const char* sources[2] = { m_Pending.Source.VertexSource.c_str(), m_Pending.Source.FragmentSource.c_str() };
+	GLCall(glShaderSource(m_Pending.VertexShader, 1, &sources[0], nullptr));
+	GLCall(glShaderSource(m_Pending.FragmentShader, 1, &sources[1], nullptr));
+	GLCall(glCompileShader(m_Pending.VertexShader));
+	GLCall(glCompileShader(m_Pending.FragmentShader));
+
+	//no status query in between: a query waits for the compile, while without one drivers keep
+	//compiling (and linking) on their own threads and the caller can go on submitting
+	m_Pending.Program = glCreateProgram();
+	GLCall(glAttachShader(m_Pending.Program, m_Pending.VertexShader));
+	GLCall(glAttachShader(m_Pending.Program, m_Pending.FragmentShader));
+	ProgramCache::Get().PrepareProgram(m_Pending.Program);
+	GLCall(glLinkProgram(m_Pending.Program));
 }
 
-void Shader::SetUniform1f(const std::string& name, float value)
+Shader::CompileStatus Shader::PollCompile(bool wait)
 {
-	GLCall(glUniform1f(GetUniformLocation(name), value));
+	if (!m_Pending.Program)
+		return m_RendererID ? CompileStatus::Linked : CompileStatus::Failed;
+
+	if (!wait && (GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile))
+	{
+		int done = GL_FALSE;
+		GLCall(glGetProgramiv(m_Pending.Program, GL_COMPLETION_STATUS_KHR, &done));
+		if (done == GL_FALSE)
+			return CompileStatus::Pending;
+	}
+
+	int linked = GL_FALSE;
+	GLCall(glGetProgramiv(m_Pending.Program, GL_LINK_STATUS, &linked));
+	if (linked == GL_FALSE)
+	{
+		//keep drawing with the old program, if there is one
+		std::cout << "Failed to build " << (m_FilePath.empty() ? "shader" : m_FilePath) << std::endl;
+		PrintPendingLogs();
+		DeletePending();
+		return CompileStatus::Failed;
+	}
+
+	ProgramCache::Get().Store(m_Pending.Source, m_Pending.Program);
+	if (m_RendererID)
+	{
+		CopyUniforms(m_RendererID, m_Pending.Program);
+		GLStateCache::Get().OnDeleteProgram(m_RendererID);
+		GLCall(glDeleteProgram(m_RendererID));
+	}
+	m_RendererID = m_Pending.Program;
+	m_Pending.Program = 0;
+	//locations belong to the old program
+	Reflect();
+
+	DeletePending();
+	return CompileStatus::Linked;
 }
 
-void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix)
+void Shader::PrintPendingLogs() const
 {
-	GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
+	unsigned int objects[3] = { m_Pending.VertexShader, m_Pending.FragmentShader, m_Pending.Program };
+	const char* names[3] = { "vertex shader", "fragment shader", "program" };
+	for (int i = 0; i < 3; i++)
+	{
+		int length = 0;
+		if (i < 2)
+		{
+			GLCall(glGetShaderiv(objects[i], GL_INFO_LOG_LENGTH, &length));
+		}
+		else
+		{
+			GLCall(glGetProgramiv(objects[i], GL_INFO_LOG_LENGTH, &length));
+		}
+		if (length <= 1)
+			continue;
+
+		std::string message(length, '\0');
+		if (i < 2)
+		{
+			GLCall(glGetShaderInfoLog(objects[i], length, &length, &message[0]));
+		}
+		else
+		{
+			GLCall(glGetProgramInfoLog(objects[i], length, &length, &message[0]));
+		}
+		std::cout << names[i] << ":" << std::endl << message << std::endl;
+	}
 }
 
-void Shader::SetUniformArrayi(const std::string& name, const int* values, unsigned int count)
+void Shader::DeletePending()
+{
+	if (m_Pending.Program)
+	{
+		GLCall(glDeleteProgram(m_Pending.Program));
+	}
+	if (m_Pending.VertexShader)
+	{
+		GLCall(glDeleteShader(m_Pending.VertexShader));
+	}
+	if (m_Pending.FragmentShader)
+	{
+		GLCall(glDeleteShader(m_Pending.FragmentShader));
+	}
+	m_Pending = PendingProgram();
+}
+
+//values of one active uniform element of a supported type, fetched and set as floats, ints or unsigned ints
+static void CopyUniform(unsigned int from, int source, int destination, unsigned int type)
 {
-	GLCall(glUniform1iv(GetUniformLocation(name), count, values));
+	float f[16];
+	int i[4];
+	unsigned int u[4];
+	switch (type)
+	{
+	case GL_FLOAT:			GLCall(glGetUniformfv(from, source, f)); GLCall(glUniform1fv(destination, 1, f)); break;
+	case GL_FLOAT_VEC2:		GLCall(glGetUniformfv(from, source, f)); GLCall(glUniform2fv(destination, 1, f)); break;
+	case GL_FLOAT_VEC3:		GLCall(glGetUniformfv(from, source, f)); GLCall(glUniform3fv(destination, 1, f)); break;
+	case GL_FLOAT_VEC4:		GLCall(glGetUniformfv(from, source, f)); GLCall(glUniform4fv(destination, 1, f)); break;
+	case GL_FLOAT_MAT2:		GLCall(glGetUniformfv(from, source, f)); GLCall(glUniformMatrix2fv(destination, 1, GL_FALSE, f)); break;
+	case GL_FLOAT_MAT3:		GLCall(glGetUniformfv(from, source, f)); GLCall(glUniformMatrix3fv(destination, 1, GL_FALSE, f)); break;
+	case GL_FLOAT_MAT4:		GLCall(glGetUniformfv(from, source, f)); GLCall(glUniformMatrix4fv(destination, 1, GL_FALSE, f)); break;
+	case GL_INT:
+	case GL_BOOL:
+	case GL_SAMPLER_2D:
+	case GL_SAMPLER_2D_ARRAY:
+	case GL_SAMPLER_3D:
+	case GL_SAMPLER_CUBE:
+	case GL_SAMPLER_2D_SHADOW:
+	case GL_INT_SAMPLER_2D:
+	case GL_UNSIGNED_INT_SAMPLER_2D:
+		GLCall(glGetUniformiv(from, source, i)); GLCall(glUniform1iv(destination, 1, i)); break;
+	case GL_INT_VEC2:
+	case GL_BOOL_VEC2:		GLCall(glGetUniformiv(from, source, i)); GLCall(glUniform2iv(destination, 1, i)); break;
+	case GL_INT_VEC3:
+	case GL_BOOL_VEC3:		GLCall(glGetUniformiv(from, source, i)); GLCall(glUniform3iv(destination, 1, i)); break;
+	case GL_INT_VEC4:
+	case GL_BOOL_VEC4:		GLCall(glGetUniformiv(from, source, i)); GLCall(glUniform4iv(destination, 1, i)); break;
+	case GL_UNSIGNED_INT:	GLCall(glGetUniformuiv(from, source, u)); GLCall(glUniform1uiv(destination, 1, u)); break;
+	case GL_UNSIGNED_INT_VEC2:	GLCall(glGetUniformuiv(from, source, u)); GLCall(glUniform2uiv(destination, 1, u)); break;
+	case GL_UNSIGNED_INT_VEC3:	GLCall(glGetUniformuiv(from, source, u)); GLCall(glUniform3uiv(destination, 1, u)); break;
+	case GL_UNSIGNED_INT_VEC4:	GLCall(glGetUniformuiv(from, source, u)); GLCall(glUniform4uiv(destination, 1, u)); break;
+	default:
+		//doubles and non-square matrices aren't used by any shader here
+		break;
+	}
 }
 
-int Shader::GetUniformLocation(const std::string& name) const
+void Shader::CopyUniforms(unsigned int from, unsigned int to) const
 {
-	if (m_LocationCache.find(name) != m_LocationCache.end())
-		return m_LocationCache[name];
+	GLStateCache::Get().UseProgram(to);
 
-	GLCall(int location = glGetUniformLocation(m_RendererID, name.c_str()));
-	if (location == -1)
+	int count = 0;
+	GLCall(glGetProgramiv(from, GL_ACTIVE_UNIFORMS, &count));
+	char name[256];
+	for (int index = 0; index < count; index++)
 	{
-		std::cout << "Wraning: uniform " << name << " doesn't exit" << std::endl;
+		int length = 0, size = 0;
+		GLenum type = 0;
+		GLCall(glGetActiveUniform(from, index, sizeof(name), &length, &size, &type, name));
+
+		//arrays are listed once as "name[0]", every element has a location of its own
+		std::string base(name, length);
+		if (size > 1 && base.size() > 3 && base.compare(base.size() - 3, 3, "[0]") == 0)
+			base.resize(base.size() - 3);
+
+		for (int element = 0; element < size; element++)
+		{
+			std::string elementName = size > 1 ? base + "[" + std::to_string(element) + "]" : base;
+			GLCall(int source = glGetUniformLocation(from, elementName.c_str()));
+			GLCall(int destination = glGetUniformLocation(to, elementName.c_str()));
+			//members of uniform blocks have no location, their values live in buffers
+			if (source != -1 && destination != -1)
+				CopyUniform(from, source, destination, type);
+		}
 	}
-	else
+
+	int blocks = 0;
+	GLCall(glGetProgramiv(from, GL_ACTIVE_UNIFORM_BLOCKS, &blocks));
+	for (int block = 0; block < blocks; block++)
 	{
-		m_LocationCache[name] = location;
+		int length = 0, binding = 0;
+		GLCall(glGetActiveUniformBlockName(from, block, sizeof(name), &length, name));
+		GLCall(glGetActiveUniformBlockiv(from, block, GL_UNIFORM_BLOCK_BINDING, &binding));
+		GLCall(unsigned int index = glGetUniformBlockIndex(to, name));
+		if (index != GL_INVALID_INDEX)
+		{
+			GLCall(glUniformBlockBinding(to, index, binding));
+		}
 	}
-	return location;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include<string>
 #include<unordered_map>
+#include<vector>
 
 #include "glm/glm.hpp"
 
@@ -11,20 +12,92 @@ struct ShaderSource
 	std::string FragmentSource;
 };
 
+//an active uniform of the linked program, found by reflection
+struct UniformInfo
+{
+	std::string Name;
+	//-1 while the program isn't linked, or when the program doesn't use the uniform
+	int Location = -1;
+	//GL type, 0 for names that were looked up but never showed up in the program
+	unsigned int Type = 0;
+	//number of array elements
+	int Count = 1;
+};
+
+//index into the uniform table of one shader, resolve it once with Shader::GetUniform() and keep it.
+//it stays valid when the shader is rebuilt by hot reload
+struct UniformHandle
+{
+	int Index = -1;
+
+	inline bool IsValid() const { return Index >= 0; }
+};
+
 class Shader
 {
 private:
+	friend class ShaderReloader;
+
+	//program compiling in the background: the first one of a deferred shader, or one rebuilt
+	//from an edited file. it replaces m_RendererID once it has linked
+	struct PendingProgram
+	{
+		unsigned int Program = 0;
+		unsigned int VertexShader = 0;
+		unsigned int FragmentShader = 0;
+		ShaderSource Source;
+	};
+
 	unsigned int m_RendererID;
 	std::string m_FilePath;
-	mutable std::unordered_map<std::string, int> m_LocationCache;
+	//uniforms by handle index, names that aren't in the program stay in here with location -1,
+	//so a missing uniform is only queried and reported once
+	mutable std::vector<UniformInfo> m_Uniforms;
+	mutable std::unordered_map<std::string, int> m_UniformIndices;
+	PendingProgram m_Pending;
 public:
-	Shader(const std::string& filePath);
+	enum class CompileStatus
+	{
+		//the driver is still compiling or linking
+		Pending,
+		//the new program is in use
+		Linked,
+		//the new program was dropped, whatever was in use before stays
+		Failed
+	};
+
+	//with "wait" false the program compiles and links in the background and the shader can't be used
+	//until PollCompile() reports it done, see ShaderBatch. a cached program binary is ready at once either way
+	Shader(const std::string& filePath, bool wait = true);
+	//from source in memory, there is no file to hot reload
+	Shader(const ShaderSource& source, bool wait = true);
 	~Shader();
 
+	//finish the program in the background, "wait" blocks until the driver is done.
+	//without parallel shader compile support every status query waits anyway
+	CompileStatus PollCompile(bool wait = false);
+	//a program is in use (a failed first compile leaves none)
+	inline bool IsReady() const { return m_RendererID != 0; }
+	inline bool IsCompiling() const { return m_Pending.Program != 0; }
+
 	void Bind() const;
 	void UnBind() const;
 
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline const std::string& GetFilePath() const { return m_FilePath; }
+
+	//look the name up once, the handle then indexes the uniform table directly
+	UniformHandle GetUniform(const std::string& name) const;
+	inline const std::vector<UniformInfo>& GetUniforms() const { return m_Uniforms; }
+
 	//set Uniform
+	void SetUniform1i(UniformHandle uniform, int value);
+	void SetUniform4f(UniformHandle uniform, float v0, float v1, float v2, float v3);
+	void SetUniform1f(UniformHandle uniform, float value);
+	void SetUniformMat4f(UniformHandle uniform, const glm::mat4& matrix);
+	void SetUniformArrayi(UniformHandle uniform, const int* values, unsigned int count);
+
+	//by name: one hash lookup per call
 	void SetUniform1i(const std::string& name, int value);
 
 	void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
@@ -36,7 +109,18 @@ public:
 
 private:
 	ShaderSource ParseShader(const std::string& filePath);
-	unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
-	unsigned int CompileShader(unsigned int type, const std::string& source);
-	int GetUniformLocation(const std::string& name) const;
+	inline int GetUniformLocation(UniformHandle uniform) const { return m_Uniforms[uniform.Index].Location; }
+	//fill the uniform table from the active uniforms of a newly linked program and
+	//bind its uniform blocks to the binding points of their names
+	void Reflect();
+
+	//create a program from the cache or start compiling and linking it
+	void Create(const ShaderSource& source, bool wait);
+	//compile both stages and link without asking for any status, the status is checked by PollCompile()
+	void StartCompile(const ShaderSource& source);
+	//print the logs of the stages and the program of a failed m_Pending
+	void PrintPendingLogs() const;
+	void DeletePending();
+	//carry the values of the default block and the uniform block bindings over to a new program
+	void CopyUniforms(unsigned int from, unsigned int to) const;
 };
\ No newline at end of file
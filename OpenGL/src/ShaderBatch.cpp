@@ -0,0 +1,80 @@
+#include "ShaderBatch.h"
+
+#include "Renderer.h"
+
+ShaderBatch::ShaderBatch()
+	:m_Failed(0)
+{
+}
+
+ShaderBatch::~ShaderBatch()
+{
+}
+
+bool ShaderBatch::IsParallelSupported()
+{
+	return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+}
+
+void ShaderBatch::SetMaxCompilerThreads(unsigned int count)
+{
+	if (GLEW_KHR_parallel_shader_compile)
+	{
+		GLCall(glMaxShaderCompilerThreadsKHR(count));
+	}
+	else if (GLEW_ARB_parallel_shader_compile)
+	{
+		GLCall(glMaxShaderCompilerThreadsARB(count));
+	}
+}
+
+std::shared_ptr<Shader> ShaderBatch::Add(const std::string& filePath)
+{
+	std::shared_ptr<Shader> shader = std::make_shared<Shader>(filePath, false);
+	Track(shader);
+	return shader;
+}
+
+std::shared_ptr<Shader> ShaderBatch::Add(const ShaderSource& source)
+{
+	std::shared_ptr<Shader> shader = std::make_shared<Shader>(source, false);
+	Track(shader);
+	return shader;
+}
+
+void ShaderBatch::Track(const std::shared_ptr<Shader>& shader)
+{
+	m_Shaders.push_back(shader);
+	//a cache hit is linked already
+	if (shader->IsCompiling())
+		m_Pending.push_back(shader.get());
+}
+
+bool ShaderBatch::Poll()
+{
+	for (auto it = m_Pending.begin(); it != m_Pending.end();)
+	{
+		Shader::CompileStatus status = (*it)->PollCompile();
+		if (status == Shader::CompileStatus::Pending)
+		{
+			++it;
+			continue;
+		}
+
+		if (status == Shader::CompileStatus::Failed)
+			m_Failed++;
+		it = m_Pending.erase(it);
+	}
+	return m_Pending.empty();
+}
+
+void ShaderBatch::Wait()
+{
+	//in submission order, by the time the first one is done the others have had a head start
+	for (Shader* shader : m_Pending)
+	{
+		if (shader->PollCompile(true) == Shader::CompileStatus::Failed)
+			m_Failed++;
+	}
+	m_Pending.clear();
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+
+//compiles many programs side by side. Add() submits every compile and link to the driver without asking
+//for a result, so with KHR_parallel_shader_compile the driver spreads them over its compiler threads;
+//Poll() checks GL_COMPLETION_STATUS_KHR and only reads status and logs of programs that are done.
+//without the extension the first status query waits, Poll() then finishes everything in one go.
+class ShaderBatch
+{
+private:
+	std::vector<std::shared_ptr<Shader> > m_Shaders;
+	//shaders not done yet, in submission order
+	std::vector<Shader*> m_Pending;
+	unsigned int m_Failed;
+public:
+	ShaderBatch();
+	~ShaderBatch();
+
+	//submit a shader file or source, the shader is usable once the batch reports it done
+	std::shared_ptr<Shader> Add(const std::string& filePath);
+	std::shared_ptr<Shader> Add(const ShaderSource& source);
+
+	//finish the programs that are done without waiting on the others, true once all are done
+	bool Poll();
+	//block until every program is done
+	void Wait();
+
+	inline bool IsDone() const { return m_Pending.empty(); }
+	inline unsigned int GetPendingCount() const { return (unsigned int)m_Pending.size(); }
+	inline unsigned int GetFailedCount() const { return m_Failed; }
+	inline const std::vector<std::shared_ptr<Shader> >& GetShaders() const { return m_Shaders; }
+
+	//driver compiles programs in the background and reports their completion
+	static bool IsParallelSupported();
+	//compiler threads the driver may use for background compiles, 0xffffffff lets it pick
+	static void SetMaxCompilerThreads(unsigned int count);
+private:
+	void Track(const std::shared_ptr<Shader>& shader);
+};
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "ShaderReloader.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "Shader.h"
+#include "FileSystem.h"
+
+std::unique_ptr<ShaderReloader> ShaderReloader::s_Instance;
+
+ShaderReloader::ShaderReloader()
+	:m_Watcher(std::make_unique<FileWatcher>()), m_Enabled(true)
+{
+}
+
+ShaderReloader::~ShaderReloader()
+{
+}
+
+ShaderReloader& ShaderReloader::Get()
+{
+	if (!s_Instance)
+		s_Instance = std::make_unique<ShaderReloader>();
+	return *s_Instance;
+}
+
+void ShaderReloader::Shutdown()
+{
+	s_Instance.reset();
+}
+
+void ShaderReloader::Register(Shader* shader)
+{
+	std::string path = FileSystem::GetCanonicalPath(shader->GetFilePath());
+	m_Shaders[path].push_back(shader);
+	m_Watcher->Watch(path);
+}
+
+void ShaderReloader::Unregister(Shader* shader)
+{
+	//shaders may outlive the reloader, don't bring it back just to forget them
+	if (!s_Instance)
+		return;
+
+	std::vector<Shader*>& shaders = s_Instance->m_Shaders[FileSystem::GetCanonicalPath(shader->GetFilePath())];
+	shaders.erase(std::remove(shaders.begin(), shaders.end(), shader), shaders.end());
+
+	std::vector<Reload>& reloads = s_Instance->m_Reloads;
+	reloads.erase(std::remove_if(reloads.begin(), reloads.end(), [shader](const Reload& reload) { return reload.Target == shader; }), reloads.end());
+}
+
+void ShaderReloader::Update()
+{
+	using clock = std::chrono::high_resolution_clock;
+	clock::time_point start = clock::now();
+
+	//the watcher keeps collecting while disabled, those edits are dropped here
+	std::vector<FileWatcher::Change> changes = m_Watcher->GetChanges();
+	for (const FileWatcher::Change& change : changes)
+	{
+		if (!m_Enabled)
+			break;
+
+		auto it = m_Shaders.find(change.FilePath);
+		if (it == m_Shaders.end())
+			continue;
+
+		for (Shader* shader : it->second)
+		{
+			std::cout << "Reloading " << shader->GetFilePath() << std::endl;
+			shader->StartCompile(shader->ParseShader(shader->GetFilePath()));
+
+			auto reload = std::find_if(m_Reloads.begin(), m_Reloads.end(), [shader](const Reload& r) { return r.Target == shader; });
+			if (reload != m_Reloads.end())
+				reload->ChangeTime = change.Time;
+			else
+				m_Reloads.push_back({ shader, change.Time });
+		}
+	}
+
+	for (auto it = m_Reloads.begin(); it != m_Reloads.end();)
+	{
+		Shader::CompileStatus status = it->Target->PollCompile();
+		if (status == Shader::CompileStatus::Pending)
+		{
+			++it;
+			continue;
+		}
+
+		if (status == Shader::CompileStatus::Linked)
+		{
+			m_Stats.Reloads++;
+			m_Stats.LastLatency = std::chrono::duration<float, std::milli>(clock::now() - it->ChangeTime).count();
+		}
+		else
+		{
+			m_Stats.Failures++;
+		}
+		it = m_Reloads.erase(it);
+	}
+
+	m_Stats.Pending = (unsigned int)m_Reloads.size();
+	m_Stats.LastUpdateTime = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+	m_Stats.MaxUpdateTime = std::max(m_Stats.MaxUpdateTime, m_Stats.LastUpdateTime);
+}
+
+void ShaderReloader::ResetStats()
+{
+	m_Stats.Reloads = 0;
+	m_Stats.Failures = 0;
+	m_Stats.LastLatency = 0.0f;
+	m_Stats.MaxUpdateTime = 0.0f;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FileWatcher.h"
+
+class Shader;
+
+//hot reload of shader files: every Shader registers its file, a FileWatcher reports edits from its own
+//thread, and Update() rebuilds the affected programs on the GL thread. a new program only replaces the
+//old one once it has linked, with the uniform values of the old one; a broken edit leaves the old
+//program in place.
+class ShaderReloader
+{
+public:
+	struct Stats
+	{
+		unsigned int Reloads = 0;
+		unsigned int Failures = 0;
+		unsigned int Pending = 0;
+		//milliseconds from noticing the edit to drawing with the new program
+		float LastLatency = 0.0f;
+		//milliseconds the last Update() took on the GL thread, and the worst so far
+		float LastUpdateTime = 0.0f;
+		float MaxUpdateTime = 0.0f;
+	};
+private:
+	friend class Shader;
+
+	struct Reload
+	{
+		Shader* Target;
+		std::chrono::high_resolution_clock::time_point ChangeTime;
+	};
+
+	static std::unique_ptr<ShaderReloader> s_Instance;
+
+	std::unique_ptr<FileWatcher> m_Watcher;
+	//canonical file path -> shaders made from it
+	std::unordered_map<std::string, std::vector<Shader*> > m_Shaders;
+	std::vector<Reload> m_Reloads;
+	bool m_Enabled;
+	Stats m_Stats;
+public:
+	ShaderReloader();
+	~ShaderReloader();
+
+	//process wide reloader, created on first use
+	static ShaderReloader& Get();
+	static void Shutdown();
+
+	//start rebuilding edited shaders and swap in the ones that finished. call once per frame on the GL thread
+	void Update();
+
+	//a disabled reloader ignores edits, the watcher thread keeps running
+	inline void SetEnabled(bool enabled) { m_Enabled = enabled; }
+	inline bool IsEnabled() const { return m_Enabled; }
+	inline bool IsUsingInotify() const { return m_Watcher->IsUsingInotify(); }
+
+	inline const Stats& GetStats() const { return m_Stats; }
+	void ResetStats();
+private:
+	void Register(Shader* shader);
+	static void Unregister(Shader* shader);
+};
\ No newline at end of file
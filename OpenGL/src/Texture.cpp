@@ -1,14 +1,70 @@
 #include "Texture.h"
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "MipGenerator.h"
+#include "PixelConverter.h"
+#include "TextureResidency.h"
 #include "GL/glew.h"
 
+#include <iostream>
+#include <utility>
+#include <vector>
+
 #include "stb_image/stb_image.h"
 
-Texture::Texture(const std::string& filePath)
-	:m_RendererID(0), m_FilePath(filePath), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(0)
+struct TextureFormatInfo
+{
+	unsigned int InternalFormat;
+	unsigned int PixelFormat;
+	unsigned int PixelType;
+	int Bytes;
+};
+
+static TextureFormatInfo GetFormatInfo(TextureFormat format)
+{
+	switch (format)
+	{
+	case TextureFormat::RGB8:		return { GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, 3 };
+	case TextureFormat::RG8:		return { GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2 };
+	case TextureFormat::R8:			return { GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1 };
+	case TextureFormat::RGBA16F:	return { GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8 };
+	case TextureFormat::RGBA32F:	return { GL_RGBA32F, GL_RGBA, GL_FLOAT, 16 };
+	case TextureFormat::R32F:		return { GL_R32F, GL_RED, GL_FLOAT, 4 };
+	default:						return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4 };
+	}
+}
+
+Texture::Texture(const std::string& filePath, const SamplerDesc& sampler, bool premultiply)
+	:m_RendererID(0), m_FilePath(filePath), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(0),
+	m_MipLevels(0), m_InternalFormat(GL_RGBA8), m_Format(TextureFormat::RGBA8),
+	m_PixelFormat(GL_RGBA), m_PixelType(GL_UNSIGNED_BYTE), m_Immutable(false), m_SamplerDesc(sampler), m_Sampler(SamplerCache::Get(sampler)), m_BindlessHandle(0),
+	m_LastUsedFrame(0), m_Evicted(false), m_Premultiplied(false), m_OriginTop(false)
 {
+	TextureResidency::Get().Register(this);
+
+	m_Premultiplied = premultiply;
+	if (!LoadFile(filePath))
+	{
+		GLCall(glGenTextures(1, &m_RendererID));
+	}
+}
+
+bool Texture::LoadFile(const std::string& filePath)
+{
+	//containers hold data ready to sample, block compressed texels can't be premultiplied anyway
+	if (ImageContainer::IsContainerFile(filePath))
+	{
+		ImageData image;
+		if (!ImageContainer::Load(filePath, image))
+			return false;
+
+		SetImage(image);
+		return true;
+	}
+
 	//flip the image up and down, since (0, 0) is at *left bottom* in the OpenGL texture coordinate.
-	stbi_set_flip_vertically_on_load(1);
+	//the flag is per thread, so loader threads decoding at the same time keep their own
+	stbi_set_flip_vertically_on_load_thread(1);
 	
 	/*
 	*	Parameters of "stbi_load"
@@ -19,42 +75,356 @@ Texture::Texture(const std::string& filePath)
 	*	int* channels_in_file: store the bits per pixel in the original image
 	*	int desired_channels: the number of commponents excepted in the output stream, eg. RGBA is 4
 	*/
-	m_LocalBuffer = stbi_load(filePath.c_str(), &m_Width, &m_Height, &m_BPP, 4);
+	int width = 0, height = 0, channels = 0;
+	m_LocalBuffer = stbi_load(filePath.c_str(), &width, &height, &channels, 4);
+	if (!m_LocalBuffer)
+		return false;
+	if (m_Premultiplied)
+		PixelConverter::Premultiply(m_LocalBuffer, (size_t)width * height);
+
+	//sampled mode (filter and wrap) lives in the shared sampler object bound next to the texture
+	SetImage(width, height, m_LocalBuffer);
+	stbi_image_free(m_LocalBuffer);
+	m_LocalBuffer = nullptr;
+	return true;
+}
+
+Texture::Texture(int width, int height, const void* data, const SamplerDesc& sampler)
+	:m_RendererID(0), m_LocalBuffer(nullptr), m_Width(width), m_Height(height), m_BPP(4),
+	m_MipLevels(0), m_InternalFormat(GL_RGBA8), m_Format(TextureFormat::RGBA8),
+	m_PixelFormat(GL_RGBA), m_PixelType(GL_UNSIGNED_BYTE), m_Immutable(false), m_SamplerDesc(sampler), m_Sampler(SamplerCache::Get(sampler)), m_BindlessHandle(0),
+	m_LastUsedFrame(0), m_Evicted(false), m_Premultiplied(false), m_OriginTop(false)
+{
+	TextureResidency::Get().Register(this);
+
+	SetImage(width, height, data);
+}
 
+Texture::Texture(int width, int height, TextureFormat format, const void* data, const SamplerDesc& sampler, int mipLevels)
+	:m_RendererID(0), m_LocalBuffer(nullptr), m_Width(width), m_Height(height), m_BPP(4),
+	m_MipLevels(0), m_InternalFormat(GL_RGBA8), m_Format(format),
+	m_PixelFormat(GL_RGBA), m_PixelType(GL_UNSIGNED_BYTE), m_Immutable(false), m_SamplerDesc(sampler), m_Sampler(SamplerCache::Get(sampler)), m_BindlessHandle(0),
+	m_LastUsedFrame(0), m_Evicted(false), m_Premultiplied(false), m_OriginTop(false)
+{
+	TextureResidency::Get().Register(this);
+
+	Allocate(width, height, format, mipLevels);
+	if (data)
+	{
+		SetData(0, 0, width, height, data);
+		GenerateMips();
+	}
+}
+
+Texture::Texture(const ImageData& image, const SamplerDesc& sampler)
+	:m_RendererID(0), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(4),
+	m_MipLevels(0), m_InternalFormat(GL_RGBA8), m_Format(TextureFormat::RGBA8),
+	m_PixelFormat(GL_RGBA), m_PixelType(GL_UNSIGNED_BYTE), m_Immutable(false), m_SamplerDesc(sampler), m_Sampler(SamplerCache::Get(sampler)), m_BindlessHandle(0),
+	m_LastUsedFrame(0), m_Evicted(false), m_Premultiplied(false), m_OriginTop(false)
+{
+	TextureResidency::Get().Register(this);
+
+	SetImage(image);
+}
+
+bool Texture::IsFormatSupported(unsigned int internalFormat)
+{
+	switch (internalFormat)
+	{
+	case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+	case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+		return GLEW_EXT_texture_compression_s3tc != 0;
+	case GL_COMPRESSED_RGBA_BPTC_UNORM:
+		return GLEW_ARB_texture_compression_bptc != 0;
+	default:
+		//RGBA8 and RGTC (BC4/BC5) are core since GL 3.0
+		return true;
+	}
+}
+
+void Texture::Allocate(int width, int height, TextureFormat format, int mipLevels)
+{
+	m_Width = width;
+	m_Height = height;
+	TextureFormatInfo info = GetFormatInfo(format);
+	m_BPP = info.Bytes;
+	m_MipLevels = MipGenerator::GetLevelCount(width, height);
+	if (mipLevels > 0 && mipLevels < m_MipLevels)
+		m_MipLevels = mipLevels;
+
+	//immutable storage can't be resized, a compressed texture carries its own level limit and a
+	//texture with a bindless handle can't be respecified: start over with a new texture object
+	if (m_RendererID && (m_Immutable || IsCompressed() || m_BindlessHandle))
+	{
+		ReleaseBindlessHandle();
+		GLStateCache::Get().OnDeleteTexture(m_RendererID);
+		GLCall(glDeleteTextures(1, &m_RendererID));
+		m_RendererID = 0;
+	}
+	if (!m_RendererID)
+	{
+		GLCall(glGenTextures(1, &m_RendererID));
+	}
+	m_InternalFormat = info.InternalFormat;
+	m_Format = format;
+	m_PixelFormat = info.PixelFormat;
+	m_PixelType = info.PixelType;
+	Bind();
+
+	if (GLEW_ARB_texture_storage)
+	{
+		GLCall(glTexStorage2D(GL_TEXTURE_2D, m_MipLevels, m_InternalFormat, m_Width, m_Height));
+		m_Immutable = true;
+	}
+	else
+	{
+		for (int level = 0; level < m_MipLevels; level++)
+		{
+			int w = m_Width >> level, h = m_Height >> level;
+			GLCall(glTexImage2D(GL_TEXTURE_2D, level, m_InternalFormat, w > 0 ? w : 1, h > 0 ? h : 1, 0, m_PixelFormat, m_PixelType, nullptr));
+		}
+		GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_MipLevels - 1));
+	}
+}
+
+void Texture::SetUnpackAlignment(bool packed) const
+{
+	if (m_BPP % 4 != 0)
+	{
+		GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, packed ? 1 : 4));
+	}
+}
+
+void Texture::SetImage(int width, int height, const void* data)
+{
+	Allocate(width, height, TextureFormat::RGBA8);
+	m_OriginTop = false;
+	if (data)
+	{
+		GLCall(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, data));
+		GenerateMips();
+	}
+}
+
+void Texture::SetImage(const ImageData& image)
+{
+	if (image.Levels.empty())
+		return;
+
+	//a single RGBA8 level is the same as raw pixels, let the GPU build the chain
+	if (image.InternalFormat == GL_RGBA8 && image.Levels.size() == 1)
+	{
+		SetImage(image.Width, image.Height, image.GetLevelData(0));
+		m_OriginTop = image.TopDown;
+		return;
+	}
+
+	if (!IsFormatSupported(image.InternalFormat))
+	{
+		std::cout << "Texture format 0x" << std::hex << image.InternalFormat << std::dec << " is not supported by the driver" << std::endl;
+		return;
+	}
+
+	//the format may change along with the size, always start from a fresh object
+	ReleaseBindlessHandle();
+	if (m_RendererID)
+	{
+		GLStateCache::Get().OnDeleteTexture(m_RendererID);
+		GLCall(glDeleteTextures(1, &m_RendererID));
+	}
 	GLCall(glGenTextures(1, &m_RendererID));
-	GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+	Bind();
 
-	//specified sampled mode of the the texture
-	
-	//smaller than real pixels
-	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-	//largere than real pixels
-	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-	//??
-	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+	m_Width = image.Width;
+	m_Height = image.Height;
+	m_MipLevels = (int)image.Levels.size();
+	m_InternalFormat = image.InternalFormat;
+	m_Format = TextureFormat::RGBA8;
+	m_PixelFormat = GL_RGBA;
+	m_PixelType = GL_UNSIGNED_BYTE;
+	m_BPP = 4;
+	m_Immutable = false;
+	m_OriginTop = image.TopDown;
+
+	//block compressed levels go up as stored, glGenerateMipmap can't produce them
+	for (int level = 0; level < m_MipLevels; level++)
+	{
+		const ImageData::Level& data = image.Levels[level];
+		if (IsCompressed())
+		{
+			GLCall(glCompressedTexImage2D(GL_TEXTURE_2D, level, m_InternalFormat, data.Width, data.Height, 0, (GLsizei)data.Size, image.GetLevelData(level)));
+		}
+		else
+		{
+			GLCall(glTexImage2D(GL_TEXTURE_2D, level, m_InternalFormat, data.Width, data.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.GetLevelData(level)));
+		}
+	}
+	//a partial chain is still complete when sampling stops at the last stored level
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_MipLevels - 1));
+}
+
+void Texture::SetData(int x, int y, int width, int height, const void* data)
+{
+	ASSERT(!IsCompressed());
+
+	Bind();
+	SetUnpackAlignment(true);
+	GLCall(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, m_PixelFormat, m_PixelType, data));
+	SetUnpackAlignment(false);
+}
+
+void Texture::SetMipData(int level, const void* data)
+{
+	ASSERT(level < m_MipLevels && !IsCompressed());
+
+	int w = m_Width >> level, h = m_Height >> level;
+	Bind();
+	SetUnpackAlignment(true);
+	GLCall(glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, w > 0 ? w : 1, h > 0 ? h : 1, m_PixelFormat, m_PixelType, data));
+	SetUnpackAlignment(false);
+}
+
+void Texture::GenerateMips()
+{
+	if (m_MipLevels <= 1 || IsCompressed())
+		return;
+
+	Bind();
+	GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+}
+
+void Texture::SwapStorage(Texture& other)
+{
+	//handles name the old objects
+	ReleaseBindlessHandle();
+	other.ReleaseBindlessHandle();
 
-	GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+	std::swap(m_RendererID, other.m_RendererID);
+	std::swap(m_Width, other.m_Width);
+	std::swap(m_Height, other.m_Height);
+	std::swap(m_BPP, other.m_BPP);
+	std::swap(m_MipLevels, other.m_MipLevels);
+	std::swap(m_InternalFormat, other.m_InternalFormat);
+	std::swap(m_Format, other.m_Format);
+	std::swap(m_PixelFormat, other.m_PixelFormat);
+	std::swap(m_PixelType, other.m_PixelType);
+	std::swap(m_Immutable, other.m_Immutable);
+	std::swap(m_OriginTop, other.m_OriginTop);
+}
+
+size_t Texture::GetMemorySize() const
+{
+	size_t size = 0;
+	for (int level = 0; level < m_MipLevels; level++)
+	{
+		int w = m_Width >> level, h = m_Height >> level;
+		size += ImageContainer::GetLevelSize(m_InternalFormat, w > 0 ? w : 1, h > 0 ? h : 1);
+	}
+	return size;
+}
+
+void Texture::SetSampler(const SamplerDesc& sampler)
+{
+	//the handle belongs to the old texture and sampler pair
+	ReleaseBindlessHandle();
+	m_SamplerDesc = sampler;
+	m_Sampler = SamplerCache::Get(sampler);
+}
+
+bool Texture::Evict(int maxSize)
+{
+	if (!IsEvictable())
+		return false;
+
+	int level = 0;
+	while (level < m_MipLevels - 1 && ((m_Width >> level) > maxSize || (m_Height >> level) > maxSize))
+		level++;
+	if (level == 0)
+		return false;
+
+	//read the level back and make it the whole texture, the chain below it is rebuilt or copied along
+	Bind();
+	if (IsCompressed())
+	{
+		ImageData image;
+		image.InternalFormat = m_InternalFormat;
+		image.TopDown = m_OriginTop;
+		image.Width = m_Width >> level > 0 ? m_Width >> level : 1;
+		image.Height = m_Height >> level > 0 ? m_Height >> level : 1;
+		for (int l = level; l < m_MipLevels; l++)
+		{
+			int w = m_Width >> l, h = m_Height >> l;
+			w = w > 0 ? w : 1;
+			h = h > 0 ? h : 1;
+			std::vector<unsigned char> data(ImageContainer::GetLevelSize(m_InternalFormat, w, h));
+			GLCall(glGetCompressedTexImage(GL_TEXTURE_2D, l, data.data()));
+			ImageContainer::AddLevel(image, w, h, data.data());
+		}
+		SetImage(image);
+	}
+	else
+	{
+		int w = m_Width >> level, h = m_Height >> level;
+		w = w > 0 ? w : 1;
+		h = h > 0 ? h : 1;
+		std::vector<unsigned char> pixels(w * h * 4);
+		GLCall(glGetTexImage(GL_TEXTURE_2D, level, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+		bool originTop = m_OriginTop;
+		SetImage(w, h, pixels.data());
+		m_OriginTop = originTop;
+	}
+	m_Evicted = true;
+	return true;
+}
+
+void Texture::Touch() const
+{
+	m_LastUsedFrame = TextureResidency::GetFrame();
+	if (m_Evicted)
+		TextureResidency::Get().RequestReload(const_cast<Texture*>(this));
+}
 
-	if (m_LocalBuffer)
+bool Texture::IsBindlessSupported()
+{
+	return GLEW_ARB_bindless_texture != 0;
+}
+
+unsigned long long Texture::GetBindlessHandle() const
+{
+	Touch();
+	if (!m_BindlessHandle)
 	{
-		stbi_image_free(m_LocalBuffer);
+		GLCall(m_BindlessHandle = glGetTextureSamplerHandleARB(m_RendererID, m_Sampler));
+		GLCall(glMakeTextureHandleResidentARB(m_BindlessHandle));
 	}
+	return m_BindlessHandle;
+}
+
+void Texture::ReleaseBindlessHandle()
+{
+	if (!m_BindlessHandle)
+		return;
+
+	GLCall(glMakeTextureHandleNonResidentARB(m_BindlessHandle));
+	m_BindlessHandle = 0;
 }
 
 Texture::~Texture()
 {
+	TextureResidency::Unregister(this);
+	ReleaseBindlessHandle();
+	GLStateCache::Get().OnDeleteTexture(m_RendererID);
 	GLCall(glDeleteTextures(1, &m_RendererID));
 }
 
 void Texture::Bind(unsigned int slot) const
 {
-	GLCall(glActiveTexture(GL_TEXTURE0 + slot));
-	GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+	Touch();
+	GLStateCache::Get().BindTexture(slot, GL_TEXTURE_2D, m_RendererID);
+	GLStateCache::Get().BindSampler(slot, m_Sampler);
 }
 
-void Texture::UnBind() const
+void Texture::UnBind(unsigned int slot) const
 {
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
-}
+	GLStateCache::Get().BindTexture(slot, GL_TEXTURE_2D, 0);
+}
\ No newline at end of file
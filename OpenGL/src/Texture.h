@@ -2,6 +2,15 @@
 
 #include<string>
 
+#include "Sampler.h"
+#include "ImageContainer.h"
+
+//uncompressed formats a texture can be created with, pixels passed in are packed rows of the matching layout
+enum class TextureFormat
+{
+	RGBA8, RGB8, RG8, R8, RGBA16F, RGBA32F, R32F
+};
+
 class Texture
 {
 private:
@@ -9,15 +18,101 @@ private:
 	std::string m_FilePath;
 	unsigned char* m_LocalBuffer;
 	int m_Width, m_Height, m_BPP;
+	int m_MipLevels;
+	//GL_RGBA8, or a block compressed format when loaded from a KTX/DDS container
+	unsigned int m_InternalFormat;
+	//client side layout of SetData() pixels, matches m_Format
+	TextureFormat m_Format;
+	unsigned int m_PixelFormat, m_PixelType;
+	//allocated with glTexStorage2D, the size can't change without a new texture object
+	bool m_Immutable;
+	SamplerDesc m_SamplerDesc;
+	unsigned int m_Sampler;
+	//resident ARB_bindless_texture handle of the texture and sampler pair, 0 until requested.
+	//a handle freezes the storage, so replacing the image releases it first
+	mutable unsigned long long m_BindlessHandle;
+	//residency: frame of the last Bind() and whether only a small mip level is left (see TextureResidency)
+	mutable unsigned int m_LastUsedFrame;
+	bool m_Evicted;
+	//color was multiplied by alpha when the file was decoded
+	bool m_Premultiplied;
+	//rows are stored top row first (see ImageData::TopDown), drawers flip V to show the image upright
+	bool m_OriginTop;
 public:
-	Texture(const std::string& filePath);
+	//.ktx, .ktx2 and .dds files are uploaded as stored (block compressed, with their mips),
+	//anything else is decoded by stb_image into RGBA8 and, with "premultiply", has its color multiplied by alpha
+	Texture(const std::string& filePath, const SamplerDesc& sampler = SamplerDesc(), bool premultiply = false);
+	Texture(const ImageData& image, const SamplerDesc& sampler = SamplerDesc());
+	//create a RGBA8 texture from pixels in memory
+	Texture(int width, int height, const void* data, const SamplerDesc& sampler = SamplerDesc());
+	//create a texture of any uncompressed format, "data" may be nullptr to fill it later with SetData().
+	//"mipLevels" of 0 allocates the full chain, textures updated every frame usually want 1
+	Texture(int width, int height, TextureFormat format, const void* data = nullptr,
+		const SamplerDesc& sampler = SamplerDesc(), int mipLevels = 0);
 	~Texture();
 
+	//replace the whole image with RGBA8 pixels of a new size (bottom row first), the mip chain is regenerated.
+	//reallocates the storage, use SetData() to change the contents of a texture that keeps its size
+	void SetImage(int width, int height, const void* data);
+	//replace the whole texture with the levels in "image", RGBA8 images with a single level get a generated chain
+	void SetImage(const ImageData& image);
+	//overwrite a rectangle of pixels in the texture's format, "data" is an offset while a pixel unpack buffer
+	//is bound. the storage stays as is and the mip chain is not touched, call GenerateMips() once all changes are in.
+	void SetData(int x, int y, int width, int height, const void* data);
+	//upload a precomputed level, e.g. from MipGenerator, instead of generating it on the GPU
+	void SetMipData(int level, const void* data);
+	//rebuild every level below the base from the base level
+	void GenerateMips();
+	//exchange the GL texture objects and everything describing them (size, format, levels) with "other".
+	//sampler, file and residency state stay, so a texture can be filled off to the side and swapped in
+	void SwapStorage(Texture& other);
+
+	void SetSampler(const SamplerDesc& sampler);
+
+	//file the image can be read from again, empty for textures made from memory.
+	//only textures with a file can be evicted by the TextureResidency
+	inline void SetFilePath(const std::string& filePath, bool premultiplied = false) { m_FilePath = filePath; m_Premultiplied = premultiplied; }
+	inline const std::string& GetFilePath() const { return m_FilePath; }
+	//shrink to the first mip level no larger than "maxSize", false if nothing was freed
+	bool Evict(int maxSize);
+	//the full image is back (see TextureLoader::Reload), the texture may be evicted again
+	inline void ClearEvicted() { m_Evicted = false; }
+	inline bool IsEvicted() const { return m_Evicted; }
+	//color already scaled by alpha, draw it with BlendMode::Premultiplied
+	inline bool IsPremultiplied() const { return m_Premultiplied; }
+	inline bool IsOriginTop() const { return m_OriginTop; }
+	inline bool IsEvictable() const { return !m_Evicted && !m_FilePath.empty() && m_MipLevels > 1 && (m_Format == TextureFormat::RGBA8 || IsCompressed()); }
+	inline unsigned int GetLastUsedFrame() const { return m_LastUsedFrame; }
+
+	//64 bit handle shaders can sample without a texture unit, made resident on first use.
+	//only valid when IsBindlessSupported()
+	unsigned long long GetBindlessHandle() const;
+	static bool IsBindlessSupported();
+
 	void Bind(unsigned int slot = 0) const;
-	void UnBind() const;
+	void UnBind(unsigned int slot = 0) const;
 
 	inline int GetWidth() const { return m_Width; }
 	inline int GetHeight() const { return m_Height; }
 	inline int GetBitPerPixrl() const { return m_BPP; }
+	inline TextureFormat GetFormat() const { return m_Format; }
+	inline int GetMipLevels() const { return m_MipLevels; }
+	inline unsigned int GetInternalFormat() const { return m_InternalFormat; }
+	inline bool IsCompressed() const { return ImageContainer::IsCompressed(m_InternalFormat); }
+	//bytes of every level in video memory, as far as the format tells
+	size_t GetMemorySize() const;
+	inline const SamplerDesc& GetSampler() const { return m_SamplerDesc; }
 	inline unsigned int GetRendererID() const { return m_RendererID; }
+
+	//whether the driver can sample "internalFormat", block formats depend on extensions
+	static bool IsFormatSupported(unsigned int internalFormat);
+private:
+	bool LoadFile(const std::string& filePath);
+	//stamp the frame and ask for a reload when evicted
+	void Touch() const;
+	void ReleaseBindlessHandle();
+	//storage for "mipLevels" levels (0 for the full chain) of a "width" x "height" image, contents undefined
+	void Allocate(int width, int height, TextureFormat format, int mipLevels = 0);
+	//row alignment of SetData() pixels, rows of 1 to 3 byte texels aren't padded to 4 bytes
+	void SetUnpackAlignment(bool packed) const;
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "TextureArray.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "Sampler.h"
+
+#include <iostream>
+
+#include "stb_image/stb_image.h"
+
+TextureArray::TextureArray(int width, int height, unsigned int layerCount)
+	:m_RendererID(0), m_Width(width), m_Height(height), m_LayerCount(layerCount), m_UsedLayers(0),
+	m_Sampler(SamplerCache::Get(SamplerDesc(TextureFilter::Linear)))
+{
+	GLCall(glGenTextures(1, &m_RendererID));
+	Bind();
+
+	//storage for every layer up front, layers are filled in with glTexSubImage3D
+	GLCall(glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, m_Width, m_Height, m_LayerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+	UnBind();
+}
+
+TextureArray::~TextureArray()
+{
+	GLStateCache::Get().OnDeleteTexture(m_RendererID);
+	GLCall(glDeleteTextures(1, &m_RendererID));
+}
+
+int TextureArray::AddLayer(const std::string& filePath)
+{
+	int width, height, bpp;
+	stbi_set_flip_vertically_on_load_thread(1);
+	unsigned char* pixels = stbi_load(filePath.c_str(), &width, &height, &bpp, 4);
+	if (!pixels)
+	{
+		std::cout << "Failed to load " << filePath << std::endl;
+		return -1;
+	}
+
+	int layer = -1;
+	if (width == m_Width && height == m_Height)
+		layer = AddLayer(pixels);
+	else
+		std::cout << filePath << " is " << width << "x" << height << ", texture array layers are " << m_Width << "x" << m_Height << std::endl;
+
+	stbi_image_free(pixels);
+	return layer;
+}
+
+int TextureArray::AddLayer(const void* data)
+{
+	if (m_UsedLayers >= m_LayerCount)
+		return -1;
+
+	unsigned int layer = m_UsedLayers++;
+	SetLayer(layer, data);
+	return (int)layer;
+}
+
+void TextureArray::SetLayer(unsigned int layer, const void* data)
+{
+	ASSERT(layer < m_LayerCount);
+
+	Bind();
+	GLCall(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_Width, m_Height, 1, GL_RGBA, GL_UNSIGNED_BYTE, data));
+}
+
+void TextureArray::Bind(unsigned int slot) const
+{
+	GLStateCache::Get().BindTexture(slot, GL_TEXTURE_2D_ARRAY, m_RendererID);
+	GLStateCache::Get().BindSampler(slot, m_Sampler);
+}
+
+void TextureArray::UnBind(unsigned int slot) const
+{
+	GLStateCache::Get().BindTexture(slot, GL_TEXTURE_2D_ARRAY, 0);
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+//GL_TEXTURE_2D_ARRAY of same sized RGBA8 layers. a batch can sample any layer
+//through one sampler, so the number of distinct images never splits it.
+class TextureArray
+{
+private:
+	unsigned int m_RendererID;
+	int m_Width, m_Height;
+	unsigned int m_LayerCount;
+	unsigned int m_UsedLayers;
+	//layers have no mip chain, the unit must not keep a mipmapping sampler of a 2D texture
+	unsigned int m_Sampler;
+public:
+	TextureArray(int width, int height, unsigned int layerCount);
+	~TextureArray();
+
+	//copy an image into the next free layer and return its index, -1 if the image
+	//can't be loaded, doesn't match the layer size or the array is full
+	int AddLayer(const std::string& filePath);
+	//same for RGBA8 pixels of the layer size
+	int AddLayer(const void* data);
+	//replace the contents of an existing layer
+	void SetLayer(unsigned int layer, const void* data);
+
+	void Bind(unsigned int slot = 0) const;
+	void UnBind(unsigned int slot = 0) const;
+
+	inline int GetWidth() const { return m_Width; }
+	inline int GetHeight() const { return m_Height; }
+	inline unsigned int GetLayerCount() const { return m_LayerCount; }
+	inline unsigned int GetUsedLayers() const { return m_UsedLayers; }
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+};
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include "TextureCache.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "GL/glew.h"
+#include "stb_image/stb_image.h"
+
+#include "FileSystem.h"
+#include "MappedFile.h"
+#include "MipGenerator.h"
+#include "PixelConverter.h"
+
+//file layout: CacheHeader, LevelCount x CacheLevel, then the levels at DataAlignment boundaries
+struct CacheHeader
+{
+	char Magic[4];
+	unsigned int Version;
+	unsigned long long SourceTime;
+	unsigned long long SourceSize;
+	unsigned long long ContentHash;
+	unsigned int Flags;
+	unsigned int InternalFormat;
+	int Width, Height;
+	unsigned int LevelCount;
+	unsigned int Reserved;
+};
+
+struct CacheLevel
+{
+	unsigned long long Offset;
+	unsigned long long Size;
+	int Width, Height;
+	unsigned int Reserved[2];
+};
+
+static const char s_Magic[4] = { 'T', 'X', 'C', 'H' };
+
+enum CacheFlags
+{
+	FlagFlipped = 1 << 0,
+	FlagPremultiplied = 1 << 1,
+	FlagMips = 1 << 2
+};
+
+static unsigned int GetFlags(const TextureCacheOptions& options)
+{
+	return FlagFlipped | (options.Premultiply ? FlagPremultiplied : 0) | (options.Mips ? FlagMips : 0);
+}
+
+static bool ReadFile(const std::string& filePath, std::vector<unsigned char>& data)
+{
+	std::ifstream stream(filePath, std::ios::binary);
+	if (!stream)
+		return false;
+	data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	return true;
+}
+
+//check the mapped file and describe its levels in "image", false if it is damaged or from another version
+static bool ReadCacheFile(const MappedFile& file, unsigned int flags, CacheHeader& header, ImageData& image)
+{
+	if (file.GetSize() < sizeof(CacheHeader))
+		return false;
+	memcpy(&header, file.GetData(), sizeof(CacheHeader));
+	if (memcmp(header.Magic, s_Magic, 4) != 0 || header.Version != TextureCache::FormatVersion || header.Flags != flags)
+		return false;
+
+	size_t tableEnd = sizeof(CacheHeader) + header.LevelCount * sizeof(CacheLevel);
+	if (header.LevelCount == 0 || tableEnd > file.GetSize())
+		return false;
+
+	image = ImageData();
+	image.InternalFormat = header.InternalFormat;
+	image.Width = header.Width;
+	image.Height = header.Height;
+	image.External = file.GetData();
+
+	const CacheLevel* levels = (const CacheLevel*)(file.GetData() + sizeof(CacheHeader));
+	for (unsigned int i = 0; i < header.LevelCount; i++)
+	{
+		const CacheLevel& level = levels[i];
+		if (level.Offset + level.Size > file.GetSize() || level.Size != ImageContainer::GetLevelSize(header.InternalFormat, level.Width, level.Height))
+			return false;
+		image.Levels.push_back({ (size_t)level.Offset, (size_t)level.Size, level.Width, level.Height });
+	}
+	return true;
+}
+
+TextureCache::TextureCache(const std::string& directory)
+	:m_Directory(directory)
+{
+	if (!FileSystem::CreateDirectories(m_Directory))
+		std::cout << "Failed to create the texture cache directory " << m_Directory << std::endl;
+}
+
+std::string TextureCache::GetCachePath(const std::string& filePath, const TextureCacheOptions& options) const
+{
+	//one file per source and option set, named by the hash of both
+	std::string key = FileSystem::GetCanonicalPath(filePath);
+	unsigned int flags = GetFlags(options);
+	unsigned long long hash = FileSystem::HashFNV1a(&flags, sizeof(flags), FileSystem::HashFNV1a(key.data(), key.size()));
+
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.texcache", hash);
+	return m_Directory + "/" + name;
+}
+
+std::shared_ptr<Texture> TextureCache::Load(const std::string& filePath, const TextureCacheOptions& options, const SamplerDesc& sampler)
+{
+	using clock = std::chrono::high_resolution_clock;
+	clock::time_point start = clock::now();
+
+	unsigned long long modifiedTime, size;
+	if (!FileSystem::GetFileInfo(filePath, modifiedTime, size))
+	{
+		std::cout << "Failed to load " << filePath << std::endl;
+		return nullptr;
+	}
+
+	unsigned int flags = GetFlags(options);
+	std::string cachePath = GetCachePath(filePath, options);
+	std::vector<unsigned char> source;
+
+	MappedFile file;
+	CacheHeader header;
+	ImageData image;
+	if (file.Open(cachePath) && ReadCacheFile(file, flags, header, image))
+	{
+		bool valid = header.SourceTime == modifiedTime && header.SourceSize == size;
+		bool revalidated = false;
+		//touched but maybe not changed, the content decides
+		if (!valid && header.SourceSize == size && ReadFile(filePath, source))
+			valid = revalidated = FileSystem::HashFNV1a(source.data(), source.size()) == header.ContentHash;
+
+		if (valid)
+		{
+			std::shared_ptr<Texture> texture = std::make_shared<Texture>(image, sampler);
+			texture->SetFilePath(filePath, options.Premultiply);
+			file.Close();
+
+			if (revalidated)
+			{
+				std::fstream stream(cachePath, std::ios::in | std::ios::out | std::ios::binary);
+				stream.seekp(offsetof(CacheHeader, SourceTime));
+				stream.write((const char*)&modifiedTime, sizeof(modifiedTime));
+				m_Stats.Revalidated++;
+			}
+
+			m_Stats.Hits++;
+			m_Stats.LastLoadTime = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+			return texture;
+		}
+	}
+	file.Close();
+	m_Stats.Misses++;
+
+	if (source.empty() && !ReadFile(filePath, source))
+	{
+		std::cout << "Failed to load " << filePath << std::endl;
+		return nullptr;
+	}
+
+	//same orientation as the Texture constructor
+	stbi_set_flip_vertically_on_load_thread(1);
+	int width, height, bpp;
+	unsigned char* pixels = stbi_load_from_memory(source.data(), (int)source.size(), &width, &height, &bpp, 4);
+	if (!pixels)
+	{
+		std::cout << "Failed to decode " << filePath << std::endl;
+		return nullptr;
+	}
+
+	if (options.Premultiply)
+		PixelConverter::Premultiply(pixels, (size_t)width * height);
+
+	image = ImageData();
+	image.InternalFormat = GL_RGBA8;
+	image.Width = width;
+	image.Height = height;
+	ImageContainer::AddLevel(image, width, height, pixels);
+	if (options.Mips)
+	{
+		std::vector<std::vector<unsigned char> > chain = MipGenerator::BuildChain(pixels, width, height);
+		int w = width, h = height;
+		for (const std::vector<unsigned char>& level : chain)
+		{
+			w = w > 1 ? w / 2 : 1;
+			h = h > 1 ? h / 2 : 1;
+			ImageContainer::AddLevel(image, w, h, level.data());
+		}
+	}
+	stbi_image_free(pixels);
+
+	if (!Store(cachePath, image, modifiedTime, size, FileSystem::HashFNV1a(source.data(), source.size()), flags))
+		std::cout << "Failed to write " << cachePath << std::endl;
+
+	std::shared_ptr<Texture> texture = std::make_shared<Texture>(image, sampler);
+	texture->SetFilePath(filePath, options.Premultiply);
+	m_Stats.LastLoadTime = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+	return texture;
+}
+
+bool TextureCache::Store(const std::string& cachePath, const ImageData& image, unsigned long long modifiedTime,
+	unsigned long long size, unsigned long long hash, unsigned int flags) const
+{
+	CacheHeader header = {};
+	memcpy(header.Magic, s_Magic, 4);
+	header.Version = FormatVersion;
+	header.SourceTime = modifiedTime;
+	header.SourceSize = size;
+	header.ContentHash = hash;
+	header.Flags = flags;
+	header.InternalFormat = image.InternalFormat;
+	header.Width = image.Width;
+	header.Height = image.Height;
+	header.LevelCount = (unsigned int)image.Levels.size();
+
+	std::vector<CacheLevel> levels(image.Levels.size());
+	unsigned long long offset = sizeof(CacheHeader) + levels.size() * sizeof(CacheLevel);
+	for (size_t i = 0; i < levels.size(); i++)
+	{
+		offset = (offset + DataAlignment - 1) / DataAlignment * DataAlignment;
+		levels[i].Offset = offset;
+		levels[i].Size = image.Levels[i].Size;
+		levels[i].Width = image.Levels[i].Width;
+		levels[i].Height = image.Levels[i].Height;
+		offset += levels[i].Size;
+	}
+
+	return FileSystem::WriteFileAtomic(cachePath, [&](std::ostream& stream)
+	{
+		stream.write((const char*)&header, sizeof(header));
+		stream.write((const char*)levels.data(), levels.size() * sizeof(CacheLevel));
+		const char padding[DataAlignment] = {};
+		for (size_t i = 0; i < levels.size(); i++)
+		{
+			stream.write(padding, (size_t)(levels[i].Offset - (unsigned long long)stream.tellp()));
+			stream.write((const char*)image.GetLevelData(i), levels[i].Size);
+		}
+	});
+}
+
+void TextureCache::Remove(const std::string& filePath, const TextureCacheOptions& options)
+{
+	remove(GetCachePath(filePath, options).c_str());
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "Texture.h"
+
+struct TextureCacheOptions
+{
+	//multiply color by alpha before storing, for premultiplied blending
+	bool Premultiply = false;
+	//store the full box-filtered chain, the upload then skips glGenerateMipmap
+	bool Mips = true;
+};
+
+//on-disk cache of decoded images. the first load of a file decodes it with stb_image and writes
+//the texels (flipped for GL, optionally premultiplied and mip-chained) into an aligned binary file;
+//later loads map that file and upload straight from the mapping, no decode and no copy.
+//an entry is valid while the source keeps its modification time and size, or, after a touch,
+//while its FNV-1a content hash still matches.
+class TextureCache
+{
+public:
+	//bumped whenever the layout of a cache file changes, older files are rebuilt
+	static const unsigned int FormatVersion = 1;
+	//level data starts at multiples of this, aligned for SIMD and page friendly
+	static const unsigned int DataAlignment = 64;
+
+	struct Stats
+	{
+		unsigned int Hits = 0;
+		unsigned int Misses = 0;
+		//hits that needed the content hash because the modification time changed
+		unsigned int Revalidated = 0;
+		float LastLoadTime = 0.0f;
+	};
+private:
+	std::string m_Directory;
+	Stats m_Stats;
+public:
+	TextureCache(const std::string& directory = "cache/textures");
+
+	//texture for "filePath", nullptr if the file can't be decoded
+	std::shared_ptr<Texture> Load(const std::string& filePath, const TextureCacheOptions& options = TextureCacheOptions(),
+		const SamplerDesc& sampler = SamplerDesc());
+
+	//delete the cache file of "filePath", the next Load decodes it again
+	void Remove(const std::string& filePath, const TextureCacheOptions& options = TextureCacheOptions());
+
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline void ResetStats() { m_Stats = Stats(); }
+private:
+	std::string GetCachePath(const std::string& filePath, const TextureCacheOptions& options) const;
+	bool Store(const std::string& cachePath, const ImageData& image, unsigned long long modifiedTime,
+		unsigned long long size, unsigned long long hash, unsigned int flags) const;
+};
\ No newline at end of file
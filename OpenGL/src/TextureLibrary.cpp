@@ -0,0 +1,121 @@
+#include "TextureLibrary.h"
+
+#include <stdio.h>
+
+#include "FileSystem.h"
+#include "ImageContainer.h"
+#include "TextureLoader.h"
+
+std::unique_ptr<TextureLibrary> TextureLibrary::s_Instance;
+
+TextureLibrary::TextureLibrary()
+	:m_PruneThreshold(64)
+{
+}
+
+TextureLibrary::~TextureLibrary()
+{
+}
+
+TextureLibrary& TextureLibrary::Get()
+{
+	if (!s_Instance)
+		s_Instance = std::make_unique<TextureLibrary>();
+	return *s_Instance;
+}
+
+void TextureLibrary::Shutdown()
+{
+	s_Instance.reset();
+}
+
+std::string TextureLibrary::MakeKey(const std::string& filePath, const TextureOptions& options)
+{
+	//everything that changes the texture object is part of the key, how it gets loaded is not.
+	//anisotropy goes in as the sampler cache applies it, requests it can't tell apart share an entry
+	char suffix[64];
+	snprintf(suffix, sizeof(suffix), "|%d|%d|%d|%d", (int)options.Sampler.Filter, (int)options.Sampler.Wrap,
+		SamplerCache::QuantizeAnisotropy(options.Sampler.Anisotropy), options.Premultiply ? 1 : 0);
+	return FileSystem::GetCanonicalPath(filePath) + suffix;
+}
+
+std::shared_ptr<Texture> TextureLibrary::Load(const std::string& filePath, const TextureOptions& options)
+{
+	std::string key = MakeKey(filePath, options);
+
+	auto it = m_Textures.find(key);
+	if (it != m_Textures.end())
+	{
+		std::shared_ptr<Texture> texture = it->second.lock();
+		if (texture)
+		{
+			m_Stats.Hits++;
+			return texture;
+		}
+	}
+	m_Stats.Misses++;
+
+	std::shared_ptr<Texture> texture;
+	if (options.UseCache)
+	{
+		if (!m_Cache)
+			m_Cache = std::make_unique<TextureCache>();
+
+		TextureCacheOptions cacheOptions;
+		cacheOptions.Premultiply = options.Premultiply;
+		texture = m_Cache->Load(filePath, cacheOptions, options.Sampler);
+		if (!texture)
+			return nullptr;
+	}
+	else if (options.Async && !ImageContainer::IsContainerFile(filePath))
+	{
+		texture = TextureLoader::Get().Load(filePath, options.Premultiply);
+		texture->SetSampler(options.Sampler);
+	}
+	else
+	{
+		texture = std::make_shared<Texture>(filePath, options.Sampler, options.Premultiply);
+	}
+	m_Textures[key] = texture;
+
+	if (m_Textures.size() >= m_PruneThreshold)
+	{
+		Prune();
+		m_PruneThreshold = m_Textures.size() * 2 > 64 ? m_Textures.size() * 2 : 64;
+	}
+	return texture;
+}
+
+void TextureLibrary::Prune()
+{
+	for (auto it = m_Textures.begin(); it != m_Textures.end();)
+	{
+		if (it->second.expired())
+			it = m_Textures.erase(it);
+		else
+			++it;
+	}
+}
+
+unsigned int TextureLibrary::GetLiveCount() const
+{
+	unsigned int count = 0;
+	for (const auto& entry : m_Textures)
+	{
+		if (!entry.second.expired())
+			count++;
+	}
+	return count;
+}
+
+size_t TextureLibrary::GetMemorySize() const
+{
+	size_t size = 0;
+	for (const auto& entry : m_Textures)
+	{
+		std::shared_ptr<Texture> texture = entry.second.lock();
+		if (texture)
+			size += texture->GetMemorySize();
+	}
+	return size;
+}
\ No newline at end of file
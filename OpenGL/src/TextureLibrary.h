@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Texture.h"
+#include "TextureCache.h"
+
+struct TextureOptions
+{
+	SamplerDesc Sampler;
+	//color multiplied by alpha when the file is decoded, to draw with BlendMode::Premultiplied
+	bool Premultiply = false;
+	//load through the on-disk TextureCache
+	bool UseCache = false;
+	//decode on the TextureLoader threads, a placeholder texel is shown until the image arrives.
+	//ignored for cached and container (.ktx/.dds) files, which need no decode
+	bool Async = false;
+};
+
+//interns textures by canonical path and options: loading a file that is already alive hands out
+//the same texture instead of decoding and uploading it again. the library only holds weak
+//references, so a texture (and its video memory) goes away with its last user.
+class TextureLibrary
+{
+public:
+	struct Stats
+	{
+		unsigned int Hits = 0;
+		unsigned int Misses = 0;
+	};
+private:
+	static std::unique_ptr<TextureLibrary> s_Instance;
+
+	std::unordered_map<std::string, std::weak_ptr<Texture> > m_Textures;
+	std::unique_ptr<TextureCache> m_Cache;
+	//entries are pruned when the map has grown past this since the last prune
+	size_t m_PruneThreshold;
+	Stats m_Stats;
+public:
+	TextureLibrary();
+	~TextureLibrary();
+
+	//process wide library, created on first use
+	static TextureLibrary& Get();
+	//drop the library and its cache handle, must be called while the context is still current
+	static void Shutdown();
+
+	//shared texture for "filePath", nullptr if a cached load fails
+	std::shared_ptr<Texture> Load(const std::string& filePath, const TextureOptions& options = TextureOptions());
+
+	//forget entries whose texture has been released
+	void Prune();
+
+	//textures currently alive and the video memory they take
+	unsigned int GetLiveCount() const;
+	size_t GetMemorySize() const;
+
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline void ResetStats() { m_Stats = Stats(); }
+private:
+	static std::string MakeKey(const std::string& filePath, const TextureOptions& options);
+};
\ No newline at end of file
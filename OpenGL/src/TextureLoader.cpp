@@ -0,0 +1,314 @@
+#include "TextureLoader.h"
+
+#include <chrono>
+#include <iostream>
+#include <string.h>
+
+#include "Renderer.h"
+#include "PixelConverter.h"
+#include "TextureResidency.h"
+#include "stb_image/stb_image.h"
+
+std::unique_ptr<TextureLoader> TextureLoader::s_Instance;
+
+TextureLoader::TextureLoader(unsigned int workerCount)
+	:m_Stop(false), m_Streaming(), m_StreamRow(0),
+	m_UsePixelBuffer(true), m_NextTicket(0)
+{
+	if (workerCount == 0)
+	{
+		unsigned int hardware = std::thread::hardware_concurrency();
+		workerCount = hardware > 1 ? hardware - 1 : 1;
+	}
+
+	for (unsigned int i = 0; i < workerCount; i++)
+		m_Workers.emplace_back(&TextureLoader::WorkerLoop, this);
+}
+
+TextureLoader::~TextureLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_JobMutex);
+		m_Stop = true;
+		m_Jobs.clear();
+	}
+	m_JobCondition.notify_all();
+
+	for (std::thread& worker : m_Workers)
+		worker.join();
+
+	for (DecodedImage& image : m_Decoded)
+	{
+		if (image.Pixels)
+			stbi_image_free(image.Pixels);
+	}
+	if (m_Streaming.Pixels)
+		stbi_image_free(m_Streaming.Pixels);
+}
+
+TextureLoader& TextureLoader::Get()
+{
+	if (!s_Instance)
+		s_Instance = std::make_unique<TextureLoader>();
+	return *s_Instance;
+}
+
+void TextureLoader::Shutdown()
+{
+	s_Instance.reset();
+}
+
+std::shared_ptr<Texture> TextureLoader::Load(const std::string& filePath, bool premultiply)
+{
+	unsigned int placeholder = PlaceholderTexel;
+	std::shared_ptr<Texture> texture = std::make_shared<Texture>(1, 1, &placeholder);
+
+	{
+		std::lock_guard<std::mutex> lock(m_JobMutex);
+		m_Jobs.push_back({ texture, nullptr, 0, filePath, premultiply });
+	}
+	m_JobCondition.notify_one();
+
+	m_Stats.Requested++;
+	return texture;
+}
+
+void TextureLoader::Reload(Texture* texture)
+{
+	unsigned int ticket = ++m_NextTicket;
+	m_ReloadTickets[texture] = ticket;
+	{
+		std::lock_guard<std::mutex> lock(m_JobMutex);
+		m_Jobs.push_back({ std::weak_ptr<Texture>(), texture, ticket, texture->GetFilePath(), texture->IsPremultiplied() });
+	}
+	m_JobCondition.notify_one();
+
+	m_Stats.Requested++;
+}
+
+void TextureLoader::CancelReload(Texture* texture)
+{
+	//an image already decoded for it no longer finds its ticket and is dropped
+	if (s_Instance)
+		s_Instance->m_ReloadTickets.erase(texture);
+}
+
+void TextureLoader::WorkerLoop()
+{
+	//(0, 0) is at the bottom left in OpenGL, same as the synchronous Texture constructor
+	stbi_set_flip_vertically_on_load_thread(1);
+
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(m_JobMutex);
+			m_JobCondition.wait(lock, [this] { return m_Stop || !m_Jobs.empty(); });
+			if (m_Stop)
+				return;
+
+			job = std::move(m_Jobs.front());
+			m_Jobs.pop_front();
+		}
+
+		DecodedImage image = { job.Target, job.Reloading, job.Ticket, job.FilePath, nullptr, 0, 0, ImageData(), job.Premultiply };
+		//nobody holds the texture any more, don't bother decoding it
+		if (!job.Reloading && job.Target.expired())
+		{
+			std::lock_guard<std::mutex> lock(m_DecodedMutex);
+			m_Decoded.push_back(std::move(image));
+			continue;
+		}
+
+		//containers hold data ready to sample, block compressed texels can't be premultiplied anyway
+		if (ImageContainer::IsContainerFile(job.FilePath))
+		{
+			if (!ImageContainer::Load(job.FilePath, image.Container))
+				image.Container = ImageData();
+		}
+		else
+		{
+			int bpp;
+			image.Pixels = stbi_load(job.FilePath.c_str(), &image.Width, &image.Height, &bpp, 4);
+			if (image.Pixels && image.Premultiplied)
+				PixelConverter::Premultiply(image.Pixels, (size_t)image.Width * image.Height);
+		}
+
+		std::lock_guard<std::mutex> lock(m_DecodedMutex);
+		m_Decoded.push_back(std::move(image));
+	}
+}
+
+bool TextureLoader::PopDecoded(DecodedImage& image)
+{
+	std::lock_guard<std::mutex> lock(m_DecodedMutex);
+	if (m_Decoded.empty())
+		return false;
+
+	image = std::move(m_Decoded.front());
+	m_Decoded.pop_front();
+	return true;
+}
+
+Texture* TextureLoader::GetTarget(const DecodedImage& image, std::shared_ptr<Texture>& holder) const
+{
+	if (!image.Reloading)
+	{
+		holder = image.Target.lock();
+		return holder.get();
+	}
+
+	auto it = m_ReloadTickets.find(image.Reloading);
+	return it != m_ReloadTickets.end() && it->second == image.Ticket ? image.Reloading : nullptr;
+}
+
+void TextureLoader::FinishImage(DecodedImage& image, Texture* texture, bool loaded)
+{
+	if (image.Reloading)
+	{
+		m_ReloadTickets.erase(image.Reloading);
+		if (loaded)
+			texture->ClearEvicted();
+		TextureResidency::Get().FinishReload(texture, loaded);
+	}
+	else if (loaded)
+	{
+		//from now on the residency manager may evict it and read the file again
+		texture->SetFilePath(image.FilePath, image.Premultiplied);
+	}
+
+	if (image.Pixels)
+		stbi_image_free(image.Pixels);
+	image.Pixels = nullptr;
+	image.Container = ImageData();
+	image.Target.reset();
+	image.Reloading = nullptr;
+
+	if (loaded)
+	{
+		m_Stats.Uploaded++;
+		m_Stats.LastUploads++;
+	}
+	else
+	{
+		m_Stats.Failed++;
+	}
+}
+
+unsigned int TextureLoader::StreamRows()
+{
+	DecodedImage& image = m_Streaming;
+	unsigned int rowSize = image.Width * 4;
+	int rows = (int)(m_PixelBuffer->GetRegionSize() / rowSize);
+	if (rows > image.Height - m_StreamRow)
+		rows = image.Height - m_StreamRow;
+	ASSERT(rows > 0);
+
+	unsigned int size = rows * rowSize;
+	memcpy(m_PixelBuffer->BeginRegion(), image.Pixels + m_StreamRow * rowSize, size);
+	const void* offset = m_PixelBuffer->CommitRegion(size);
+	m_StreamTexture->SetData(0, m_StreamRow, image.Width, rows, offset);
+	m_PixelBuffer->UnBind();
+
+	m_StreamRow += rows;
+	return size;
+}
+
+void TextureLoader::ProcessUploads(float budgetMs)
+{
+	using clock = std::chrono::high_resolution_clock;
+	clock::time_point start = clock::now();
+
+	if (m_UsePixelBuffer && !m_PixelBuffer)
+		m_PixelBuffer = std::make_unique<PixelUnpackBuffer>((unsigned int)PixelRegionSize, (unsigned int)PixelRegionCount);
+
+	m_Stats.LastUploads = 0;
+	m_Stats.LastUploadBytes = 0;
+	//every chunk gets a region of its own, so chunks of one pass never wait on each other
+	unsigned int chunks = 0;
+	while (!m_PixelBuffer || chunks < m_PixelBuffer->GetRegionCount())
+	{
+		if (!m_Streaming.Pixels)
+		{
+			DecodedImage image;
+			if (!PopDecoded(image))
+				break;
+
+			std::shared_ptr<Texture> holder;
+			Texture* texture = GetTarget(image, holder);
+			if (!texture)
+			{
+				if (image.Pixels)
+					stbi_image_free(image.Pixels);
+				m_Stats.Cancelled++;
+				continue;
+			}
+			if (!image.IsDecoded())
+			{
+				std::cout << "Failed to load " << image.FilePath << std::endl;
+				FinishImage(image, texture, false);
+				continue;
+			}
+
+			//containers go up in one call, as does everything without the pixel buffer
+			if (!image.Pixels || !m_UsePixelBuffer)
+			{
+				if (image.Pixels)
+				{
+					texture->SetImage(image.Width, image.Height, image.Pixels);
+					m_Stats.LastUploadBytes += image.Width * image.Height * 4;
+				}
+				else
+				{
+					texture->SetImage(image.Container);
+					m_Stats.LastUploadBytes += (unsigned int)image.Container.Data.size();
+				}
+				FinishImage(image, texture, true);
+
+				if (std::chrono::duration<float, std::milli>(clock::now() - start).count() >= budgetMs)
+					break;
+				continue;
+			}
+
+			//allocate the full size now, the rows follow in chunks over the next frames while
+			//the target keeps drawing its placeholder or small level
+			m_StreamTexture = std::make_unique<Texture>(image.Width, image.Height, nullptr, texture->GetSampler());
+			m_Streaming = std::move(image);
+			m_StreamRow = 0;
+		}
+
+		std::shared_ptr<Texture> holder;
+		Texture* texture = GetTarget(m_Streaming, holder);
+		if (!texture)
+		{
+			//released halfway through
+			stbi_image_free(m_Streaming.Pixels);
+			m_Streaming.Pixels = nullptr;
+			m_StreamTexture.reset();
+			m_Stats.Cancelled++;
+			continue;
+		}
+
+		m_Stats.LastUploadBytes += StreamRows();
+		chunks++;
+		if (m_StreamRow >= m_Streaming.Height)
+		{
+			m_StreamTexture->GenerateMips();
+			texture->SwapStorage(*m_StreamTexture);
+			m_StreamTexture.reset();
+			FinishImage(m_Streaming, texture, true);
+		}
+
+		if (std::chrono::duration<float, std::milli>(clock::now() - start).count() >= budgetMs)
+			break;
+	}
+
+	if (m_PixelBuffer)
+		m_Stats.PixelBufferStalls = m_PixelBuffer->GetStallCount();
+	m_Stats.LastUploadTime = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+}
+
+void TextureLoader::SetUsePixelBuffer(bool enable)
+{
+	m_UsePixelBuffer = enable;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Texture.h"
+#include "PixelUnpackBuffer.h"
+
+//decodes image files on worker threads and uploads them on the GL thread.
+//Load() returns right away with a texture holding a single placeholder texel,
+//the real image replaces it during a later ProcessUploads(). Reload() does the same for
+//textures the TextureResidency evicted, which keep drawing their small level meanwhile.
+class TextureLoader
+{
+public:
+	//magenta, stands out while an image is still on its way
+	static const unsigned int PlaceholderTexel = 0xffff00ff;
+	//images are streamed through a ring of unpack regions in chunks of whole rows
+	static const unsigned int PixelRegionSize = 4 * 1024 * 1024;
+	static const unsigned int PixelRegionCount = 3;
+
+	struct Stats
+	{
+		unsigned int Requested = 0;
+		unsigned int Uploaded = 0;
+		unsigned int Failed = 0;
+		//textures released before their image arrived
+		unsigned int Cancelled = 0;
+		//uploads done and time spent by the last ProcessUploads()
+		unsigned int LastUploads = 0;
+		unsigned int LastUploadBytes = 0;
+		float LastUploadTime = 0.0f;
+		//times the pixel buffer ring had to wait for the GPU
+		unsigned int PixelBufferStalls = 0;
+	};
+private:
+	struct Job
+	{
+		std::weak_ptr<Texture> Target;
+		//reloads target a texture nobody shares, it is matched by pointer and ticket (see m_ReloadTickets)
+		Texture* Reloading;
+		unsigned int Ticket;
+		std::string FilePath;
+		bool Premultiply;
+	};
+
+	struct DecodedImage
+	{
+		std::weak_ptr<Texture> Target;
+		Texture* Reloading;
+		unsigned int Ticket;
+		std::string FilePath;
+		//decoded RGBA8 rows, nullptr for containers and when decoding failed
+		unsigned char* Pixels;
+		int Width, Height;
+		//KTX/DDS files, uploaded as stored in a single call
+		ImageData Container;
+		bool Premultiplied;
+
+		inline bool IsDecoded() const { return Pixels || !Container.Levels.empty(); }
+	};
+
+	static std::unique_ptr<TextureLoader> s_Instance;
+
+	std::vector<std::thread> m_Workers;
+	bool m_Stop;
+
+	std::mutex m_JobMutex;
+	std::condition_variable m_JobCondition;
+	std::deque<Job> m_Jobs;
+
+	std::mutex m_DecodedMutex;
+	std::deque<DecodedImage> m_Decoded;
+
+	//GL thread only: the image currently streamed through m_PixelBuffer (Pixels is nullptr when idle).
+	//its rows go into a texture of their own, which replaces the target's storage once it is complete
+	std::unique_ptr<PixelUnpackBuffer> m_PixelBuffer;
+	DecodedImage m_Streaming;
+	std::unique_ptr<Texture> m_StreamTexture;
+	int m_StreamRow;
+	bool m_UsePixelBuffer;
+
+	//GL thread only: ticket of the latest reload of every texture with one in flight. a texture
+	//destroyed meanwhile drops its entry, and a new one at the same address gets a new ticket
+	std::unordered_map<Texture*, unsigned int> m_ReloadTickets;
+	unsigned int m_NextTicket;
+
+	Stats m_Stats;
+public:
+	//a worker count of 0 picks one less than the hardware threads
+	TextureLoader(unsigned int workerCount = 0);
+	~TextureLoader();
+
+	//process wide loader, created on first use
+	static TextureLoader& Get();
+	//join the workers and drop queued work, must be called while the context is still current
+	static void Shutdown();
+
+	//"premultiply" multiplies the color by alpha on the worker thread
+	std::shared_ptr<Texture> Load(const std::string& filePath, bool premultiply = false);
+	//read the file of an evicted texture again. it keeps its small level until the full image is
+	//uploaded, then is no longer evicted and TextureResidency::FinishReload() is told
+	void Reload(Texture* texture);
+	//forget the reload of a texture that is being destroyed
+	static void CancelReload(Texture* texture);
+
+	//upload decoded images until "budgetMs" milliseconds have passed, at least one image or chunk
+	//per call so the queue always moves. call once per frame on the GL thread.
+	void ProcessUploads(float budgetMs);
+
+	//stream through the pixel unpack buffer in row chunks (default), or upload each image in one call
+	void SetUsePixelBuffer(bool enable);
+	inline bool IsUsingPixelBuffer() const { return m_UsePixelBuffer; }
+
+	inline unsigned int GetPendingCount() const { return m_Stats.Requested - m_Stats.Uploaded - m_Stats.Failed - m_Stats.Cancelled; }
+	inline const Stats& GetStats() const { return m_Stats; }
+private:
+	void WorkerLoop();
+
+	bool PopDecoded(DecodedImage& image);
+	//texture "image" goes to, nullptr once it was released. "holder" keeps a loaded texture alive
+	Texture* GetTarget(const DecodedImage& image, std::shared_ptr<Texture>& holder) const;
+	void FinishImage(DecodedImage& image, Texture* texture, bool loaded);
+	//upload the next chunk of rows of m_Streaming into m_StreamTexture, returns the bytes uploaded
+	unsigned int StreamRows();
+};
\ No newline at end of file
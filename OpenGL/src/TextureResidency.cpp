@@ -0,0 +1,162 @@
+#include "TextureResidency.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "Texture.h"
+#include "TextureLoader.h"
+
+std::unique_ptr<TextureResidency> TextureResidency::s_Instance;
+unsigned int TextureResidency::s_Frame = 1;
+
+static double GetTimeMs()
+{
+	using clock = std::chrono::high_resolution_clock;
+	return std::chrono::duration<double, std::milli>(clock::now().time_since_epoch()).count();
+}
+
+TextureResidency::TextureResidency()
+	:m_Budget(0), m_EvictedSize(32)
+{
+}
+
+TextureResidency::~TextureResidency()
+{
+}
+
+TextureResidency& TextureResidency::Get()
+{
+	if (!s_Instance)
+		s_Instance = std::make_unique<TextureResidency>();
+	return *s_Instance;
+}
+
+void TextureResidency::Shutdown()
+{
+	s_Instance.reset();
+}
+
+void TextureResidency::Register(Texture* texture)
+{
+	m_Textures.insert(texture);
+}
+
+void TextureResidency::Unregister(Texture* texture)
+{
+	//textures may outlive the manager, don't bring it back just to forget them
+	if (!s_Instance)
+		return;
+
+	s_Instance->m_Textures.erase(texture);
+	std::deque<ReloadRequest>& reloads = s_Instance->m_Reloads;
+	for (auto it = reloads.begin(); it != reloads.end(); ++it)
+	{
+		if (it->Target != texture)
+			continue;
+
+		if (it->Queued)
+			TextureLoader::CancelReload(texture);
+		reloads.erase(it);
+		return;
+	}
+}
+
+void TextureResidency::RequestReload(Texture* texture)
+{
+	//bound several times before the next Update()
+	for (const ReloadRequest& request : m_Reloads)
+	{
+		if (request.Target == texture)
+			return;
+	}
+	m_Reloads.push_back({ texture, GetTimeMs(), false });
+}
+
+void TextureResidency::FinishReload(Texture* texture, bool loaded)
+{
+	for (auto it = m_Reloads.begin(); it != m_Reloads.end(); ++it)
+	{
+		if (it->Target != texture)
+			continue;
+
+		if (loaded)
+		{
+			m_Stats.Reloads++;
+			m_Stats.LastReloadLatency = (float)(GetTimeMs() - it->Time);
+			m_Stats.MaxReloadLatency = std::max(m_Stats.MaxReloadLatency, m_Stats.LastReloadLatency);
+		}
+		else
+		{
+			m_Stats.FailedReloads++;
+		}
+		m_Reloads.erase(it);
+		return;
+	}
+}
+
+void TextureResidency::Update()
+{
+	//decoding and uploading happen in the loader, off the frame
+	for (ReloadRequest& request : m_Reloads)
+	{
+		if (!request.Queued)
+		{
+			TextureLoader::Get().Reload(request.Target);
+			request.Queued = true;
+		}
+	}
+
+	size_t resident = 0;
+	unsigned int evicted = 0;
+	for (const Texture* texture : m_Textures)
+	{
+		resident += texture->GetMemorySize();
+		if (texture->IsEvicted())
+			evicted++;
+	}
+
+	if (m_Budget && resident > m_Budget)
+	{
+		//least recently used first, skipping what the frame just drawn needed
+		std::vector<Texture*> candidates;
+		for (Texture* texture : m_Textures)
+		{
+			if (texture->IsEvictable() && texture->GetLastUsedFrame() < s_Frame)
+				candidates.push_back(texture);
+		}
+		std::sort(candidates.begin(), candidates.end(), [](const Texture* a, const Texture* b)
+			{ return a->GetLastUsedFrame() < b->GetLastUsedFrame(); });
+
+		for (Texture* texture : candidates)
+		{
+			if (resident <= m_Budget)
+				break;
+
+			size_t size = texture->GetMemorySize();
+			if (texture->Evict(m_EvictedSize))
+			{
+				resident -= size - texture->GetMemorySize();
+				evicted++;
+				m_Stats.Evictions++;
+			}
+		}
+	}
+
+	m_Stats.TextureCount = (unsigned int)m_Textures.size();
+	m_Stats.EvictedCount = evicted;
+	m_Stats.ResidentBytes = resident;
+	m_Stats.OverBudget = m_Budget && resident > m_Budget;
+	m_Stats.PendingReloads = (unsigned int)m_Reloads.size();
+
+	s_Frame++;
+}
+
+void TextureResidency::ResetStats()
+{
+	m_Stats.Evictions = 0;
+	m_Stats.Reloads = 0;
+	m_Stats.FailedReloads = 0;
+	m_Stats.LastReloadLatency = 0.0f;
+	m_Stats.MaxReloadLatency = 0.0f;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <unordered_set>
+
+class Texture;
+
+//keeps the video memory of all textures under a budget. textures remember the frame they were last
+//bound in; when the total goes over the budget, the least recently used ones that can be read from
+//disk again are shrunk to a small mip level. binding a shrunk texture queues it for a full reload,
+//which the next Update() hands to the TextureLoader. the small level stands in until the loader
+//has decoded the file on a worker and uploaded it.
+class TextureResidency
+{
+public:
+	struct Stats
+	{
+		unsigned int TextureCount = 0;
+		unsigned int EvictedCount = 0;
+		size_t ResidentBytes = 0;
+		//textures the last frame used are never evicted, so the budget can't always be met
+		bool OverBudget = false;
+		unsigned int Evictions = 0;
+		unsigned int Reloads = 0;
+		unsigned int FailedReloads = 0;
+		//reloads requested or in the loader, not yet back
+		unsigned int PendingReloads = 0;
+		//milliseconds from the bind that found the texture evicted until it was full size again
+		float LastReloadLatency = 0.0f;
+		float MaxReloadLatency = 0.0f;
+	};
+private:
+	friend class Texture;
+	friend class TextureLoader;
+
+	struct ReloadRequest
+	{
+		Texture* Target;
+		double Time;
+		//handed to the TextureLoader, the request stays until the loader reports back
+		bool Queued;
+	};
+
+	static std::unique_ptr<TextureResidency> s_Instance;
+	static unsigned int s_Frame;
+
+	std::unordered_set<Texture*> m_Textures;
+	std::deque<ReloadRequest> m_Reloads;
+	//0 means no budget
+	size_t m_Budget;
+	//evicted textures keep the first level no larger than this in either dimension, 1 leaves a single texel
+	int m_EvictedSize;
+	Stats m_Stats;
+public:
+	TextureResidency();
+	~TextureResidency();
+
+	//process wide manager, created on first use
+	static TextureResidency& Get();
+	static void Shutdown();
+
+	//frame number stamped on textures when they are bound
+	inline static unsigned int GetFrame() { return s_Frame; }
+
+	//queue reloads of textures touched while evicted, then evict until the budget is met.
+	//call once per frame on the GL thread, before drawing.
+	void Update();
+
+	inline void SetBudget(size_t bytes) { m_Budget = bytes; }
+	inline size_t GetBudget() const { return m_Budget; }
+	inline void SetEvictedSize(int size) { m_EvictedSize = size > 1 ? size : 1; }
+	inline int GetEvictedSize() const { return m_EvictedSize; }
+
+	inline const Stats& GetStats() const { return m_Stats; }
+	void ResetStats();
+private:
+	//called by every texture when it is created and destroyed
+	void Register(Texture* texture);
+	static void Unregister(Texture* texture);
+	//called by Texture::Bind() on an evicted texture
+	void RequestReload(Texture* texture);
+	//called by the TextureLoader once the image of a queued reload is uploaded, or failed to load
+	void FinishReload(Texture* texture, bool loaded);
+};
\ No newline at end of file
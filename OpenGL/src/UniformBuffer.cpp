@@ -0,0 +1,87 @@
+#include "UniformBuffer.h"
+
+#include <iostream>
+#include <string.h>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+std::unordered_map<std::string, unsigned int> UniformBuffer::s_BindingPoints;
+
+UniformBuffer::UniformBuffer(const std::string& blockName, const UniformBufferLayout& layout)
+	:m_Layout(layout), m_Binding(GetBindingPoint(blockName)), m_Data(layout.GetSize(), 0),
+	m_DirtyBegin(0), m_DirtyEnd(0), m_UploadCount(0)
+{
+	GLCall(glGenBuffers(1, &m_RendererID));
+	GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+	GLCall(glBufferData(GL_UNIFORM_BUFFER, m_Data.size(), m_Data.data(), GL_DYNAMIC_DRAW));
+	GLStateCache::Get().BindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_RendererID);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+	GLStateCache::Get().OnDeleteBuffer(m_RendererID);
+	GLCall(glDeleteBuffers(1, &m_RendererID));
+}
+
+void UniformBuffer::SetData(const std::string& name, unsigned int index, const void* data, unsigned int size)
+{
+	const UniformBufferElement* element = m_Layout.Find(name);
+	if (!element)
+	{
+		std::cout << "Warning: uniform block member " << name << " doesn't exist!" << std::endl;
+		return;
+	}
+	ASSERT(index < element->count && size <= element->stride);
+	SetData(element->offset + index * element->stride, size, data);
+}
+
+void UniformBuffer::SetData(unsigned int offset, unsigned int size, const void* data)
+{
+	ASSERT(offset + size <= m_Data.size());
+	if (memcmp(&m_Data[offset], data, size) == 0)
+		return;
+
+	memcpy(&m_Data[offset], data, size);
+	if (m_DirtyBegin == m_DirtyEnd)
+	{
+		m_DirtyBegin = offset;
+		m_DirtyEnd = offset + size;
+	}
+	else
+	{
+		m_DirtyBegin = offset < m_DirtyBegin ? offset : m_DirtyBegin;
+		m_DirtyEnd = offset + size > m_DirtyEnd ? offset + size : m_DirtyEnd;
+	}
+}
+
+void UniformBuffer::Bind()
+{
+	if (m_DirtyBegin != m_DirtyEnd)
+	{
+		GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+		GLCall(glBufferSubData(GL_UNIFORM_BUFFER, m_DirtyBegin, m_DirtyEnd - m_DirtyBegin, &m_Data[m_DirtyBegin]));
+		m_DirtyBegin = m_DirtyEnd = 0;
+		m_UploadCount++;
+	}
+	GLStateCache::Get().BindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_RendererID);
+}
+
+unsigned int UniformBuffer::GetBindingPoint(const std::string& blockName)
+{
+	auto it = s_BindingPoints.find(blockName);
+	if (it != s_BindingPoints.end())
+		return it->second;
+
+	int maxBindings = 0;
+	GLCall(glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &maxBindings));
+	unsigned int binding = (unsigned int)s_BindingPoints.size();
+	if (binding >= (unsigned int)maxBindings)
+	{
+		//blocks past the limit share the last point, only one of them can be fed at a time
+		std::cout << "Warning: no uniform buffer binding point left for " << blockName << std::endl;
+		binding = maxBindings - 1;
+	}
+	s_BindingPoints[blockName] = binding;
+	return binding;
+}
\ No newline at end of file
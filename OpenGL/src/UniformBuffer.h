@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "UniformBufferLayout.h"
+
+//GL_UNIFORM_BUFFER holding one uniform block. members are written into a copy on the CPU and
+//uploaded together when the buffer is bound, so a block shared by any number of programs costs
+//one upload per change instead of one glUniform* per program
+class UniformBuffer
+{
+private:
+	unsigned int m_RendererID;
+	UniformBufferLayout m_Layout;
+	unsigned int m_Binding;
+
+	std::vector<unsigned char> m_Data;
+	//bytes [m_DirtyBegin, m_DirtyEnd) changed since the last upload
+	unsigned int m_DirtyBegin;
+	unsigned int m_DirtyEnd;
+	unsigned int m_UploadCount;
+
+	//block name -> binding point, shared by every program and buffer
+	static std::unordered_map<std::string, unsigned int> s_BindingPoints;
+public:
+	//buffer for the block "blockName", bound to the binding point of that name
+	UniformBuffer(const std::string& blockName, const UniformBufferLayout& layout);
+	~UniformBuffer();
+
+	//member "name" (element "index" of an array), writing the value it already has changes nothing
+	template<typename T>
+	void Set(const std::string& name, const T& value, unsigned int index = 0)
+	{
+		SetData(name, index, &value, sizeof(T));
+	}
+	void SetData(const std::string& name, unsigned int index, const void* data, unsigned int size);
+	//raw bytes at "offset" of the block
+	void SetData(unsigned int offset, unsigned int size, const void* data);
+
+	//upload the changes with one glBufferSubData and make sure the buffer is on its binding point
+	void Bind();
+
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline unsigned int GetBinding() const { return m_Binding; }
+	inline const UniformBufferLayout& GetLayout() const { return m_Layout; }
+	inline unsigned int GetUploadCount() const { return m_UploadCount; }
+
+	//binding point of a block name, handed out the first time the name is asked for.
+	//shaders bind every block they declare to it when they link
+	static unsigned int GetBindingPoint(const std::string& blockName);
+};
\ No newline at end of file
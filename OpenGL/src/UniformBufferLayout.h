@@ -0,0 +1,165 @@
+#pragma once
+
+#include "GL/glew.h"
+#include "Renderer.h"
+
+#include "glm/glm.hpp"
+
+#include<string>
+#include<vector>
+
+//packing rules of an interface block, std430 is only valid for shader storage blocks
+enum class UniformLayoutStandard
+{
+	Std140, Std430
+};
+
+struct UniformBufferElement
+{
+	std::string name;
+	unsigned int type;
+	//array elements, 1 for a plain member
+	unsigned int count;
+	//declared as an array in GLSL, which "count" alone can't tell for a one element array
+	bool array;
+	//bytes from the start of the block
+	unsigned int offset;
+	//bytes between array elements, the size of the member for a plain one
+	unsigned int stride;
+
+	//size and base alignment of one value of the type, before any array rounding
+	static unsigned int GetSizeOfGLType(unsigned int type)
+	{
+		switch (type)
+		{
+		case GL_FLOAT:			return 4;
+		case GL_INT:			return 4;
+		case GL_UNSIGNED_INT:	return 4;
+		case GL_FLOAT_VEC2:		return 8;
+		case GL_FLOAT_VEC3:		return 12;
+		case GL_FLOAT_VEC4:		return 16;
+		case GL_FLOAT_MAT4:		return 64;
+		default:
+			ASSERT(false);
+			return 0;
+		}
+	}
+	static unsigned int GetAlignmentOfGLType(unsigned int type)
+	{
+		switch (type)
+		{
+		case GL_FLOAT:			return 4;
+		case GL_INT:			return 4;
+		case GL_UNSIGNED_INT:	return 4;
+		case GL_FLOAT_VEC2:		return 8;
+		//a vec3 takes the alignment of a vec4, a matrix that of its column vectors
+		case GL_FLOAT_VEC3:		return 16;
+		case GL_FLOAT_VEC4:		return 16;
+		case GL_FLOAT_MAT4:		return 16;
+		default:
+			ASSERT(false);
+			return 0;
+		}
+	}
+};
+
+//offsets of the members of a uniform block, pushed in the order they are declared in GLSL
+class UniformBufferLayout
+{
+private:
+	std::vector<UniformBufferElement> m_Elements;
+	UniformLayoutStandard m_Standard;
+	unsigned int m_Size;
+	unsigned int m_Alignment;
+public:
+	UniformBufferLayout(UniformLayoutStandard standard = UniformLayoutStandard::Std140)
+		:m_Standard(standard), m_Size(0), m_Alignment(standard == UniformLayoutStandard::Std140 ? 16 : 4)
+	{}
+
+	//"array" marks a GLSL array, which any "count" above 1 implies. it matters for T x[1],
+	//which std140 strides like every other array instead of packing it like a plain T
+	template<typename T>
+	void Push(const std::string& /*name*/, unsigned int /*count*/ = 1, bool /*array*/ = false)
+	{
+		static_assert(false);
+	}
+
+	template<>
+	void Push<float>(const std::string& name, unsigned int count, bool array)
+	{
+		PushElement(name, GL_FLOAT, count, array || count > 1);
+	}
+
+	template<>
+	void Push<int>(const std::string& name, unsigned int count, bool array)
+	{
+		PushElement(name, GL_INT, count, array || count > 1);
+	}
+
+	template<>
+	void Push<unsigned int>(const std::string& name, unsigned int count, bool array)
+	{
+		PushElement(name, GL_UNSIGNED_INT, count, array || count > 1);
+	}
+
+	template<>
+	void Push<glm::vec2>(const std::string& name, unsigned int count, bool array)
+	{
+		PushElement(name, GL_FLOAT_VEC2, count, array || count > 1);
+	}
+
+	template<>
+	void Push<glm::vec3>(const std::string& name, unsigned int count, bool array)
+	{
+		PushElement(name, GL_FLOAT_VEC3, count, array || count > 1);
+	}
+
+	template<>
+	void Push<glm::vec4>(const std::string& name, unsigned int count, bool array)
+	{
+		PushElement(name, GL_FLOAT_VEC4, count, array || count > 1);
+	}
+
+	template<>
+	void Push<glm::mat4>(const std::string& name, unsigned int count, bool array)
+	{
+		PushElement(name, GL_FLOAT_MAT4, count, array || count > 1);
+	}
+
+	//nullptr if there is no member "name"
+	const UniformBufferElement* Find(const std::string& name) const
+	{
+		for (const UniformBufferElement& element : m_Elements)
+		{
+			if (element.name == name)
+				return &element;
+		}
+		return nullptr;
+	}
+
+	inline const std::vector<UniformBufferElement>& GetElements() const { return m_Elements; }
+	inline UniformLayoutStandard GetStandard() const { return m_Standard; }
+	//size of the whole block, padded to the alignment of its largest member (16 bytes at least in std140)
+	inline unsigned int GetSize() const { return RoundUp(m_Size, m_Alignment); }
+private:
+	static unsigned int RoundUp(unsigned int value, unsigned int alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	void PushElement(const std::string& name, unsigned int type, unsigned int count, bool array)
+	{
+		unsigned int size = UniformBufferElement::GetSizeOfGLType(type);
+		unsigned int alignment = UniformBufferElement::GetAlignmentOfGLType(type);
+		//std140 rounds the alignment of array elements up to that of a vec4, std430 doesn't
+		if (m_Standard == UniformLayoutStandard::Std140 && array)
+			alignment = RoundUp(alignment, 16);
+		unsigned int stride = array ? RoundUp(size, alignment) : size;
+
+		unsigned int offset = RoundUp(m_Size, alignment);
+		m_Elements.push_back({ name, type, count, array, offset, stride });
+		m_Size = offset + stride * count;
+		if (alignment > m_Alignment)
+			m_Alignment = alignment;
+	}
+};
\ No newline at end of file
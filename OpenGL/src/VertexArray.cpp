@@ -1,25 +1,28 @@
 #include "VertexArray.h"
 
 #include "Renderer.h"
+#include "GLStateCache.h"
 
 VertexArray::VertexArray()
+	:m_AttribCount(0)
 {
 	GLCall(glGenVertexArrays(1, &m_RendererID));
 }
 
 VertexArray::~VertexArray()
 {
+	GLStateCache::Get().OnDeleteVertexArray(m_RendererID);
 	GLCall(glDeleteVertexArrays(1, &m_RendererID));
 }
 
 void VertexArray::Bind() const
 {
-	GLCall(glBindVertexArray(m_RendererID));
+	GLStateCache::Get().BindVertexArray(m_RendererID);
 }
 
 void VertexArray::UnBind() const
 {
-	GLCall(glBindVertexArray(0));
+	GLStateCache::Get().BindVertexArray(0);
 }
 
 void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout)
@@ -31,8 +34,29 @@ void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& la
 	for (int i = 0; i < elements.size(); i++)
 	{
 		const auto& element = elements[i];
-		GLCall(glEnableVertexAttribArray(i));
-		GLCall(glVertexAttribPointer(i, element.count, element.type, element.normalized, layout.GetStride(), (const void*)offset));
+		unsigned int index = m_AttribCount++;
+		GLCall(glEnableVertexAttribArray(index));
+		GLCall(glVertexAttribPointer(index, element.count, element.type, element.normalized, layout.GetStride(), (const void*)offset));
+		if (element.divisor)
+		{
+			GLCall(glVertexAttribDivisor(index, element.divisor));
+			m_InstanceAttribs.push_back({ element, vb.GetRendererID(), index, layout.GetStride(), offset });
+		}
 		offset += element.count * VertexBufferElement::GetSizeOfGLType(element.type);
 	}
+}
+
+void VertexArray::SetBaseInstance(unsigned int baseInstance) const
+{
+	Bind();
+	for (const InstanceAttrib& attrib : m_InstanceAttribs)
+	{
+		//instance i of the draw reads element (i + baseInstance) / divisor, which only shifts by whole
+		//elements when the base instance is a multiple of the divisor
+		ASSERT(baseInstance % attrib.Element.divisor == 0);
+		size_t offset = attrib.Offset + (size_t)(baseInstance / attrib.Element.divisor) * attrib.Stride;
+		GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, attrib.Buffer);
+		GLCall(glVertexAttribPointer(attrib.Index, attrib.Element.count, attrib.Element.type, attrib.Element.normalized,
+			attrib.Stride, (const void*)offset));
+	}
 }
\ No newline at end of file
@@ -3,10 +3,25 @@
 #include "VertexBuffer.h"
 #include "VertexBufferLayout.h"
 
+#include <vector>
+
 class VertexArray
 {
 private:
+	//an attribute with a divisor, kept so it can be pointed at another base instance
+	struct InstanceAttrib
+	{
+		VertexBufferElement Element;
+		unsigned int Buffer;
+		unsigned int Index;
+		unsigned int Stride;
+		unsigned int Offset;
+	};
+
 	unsigned int m_RendererID;
+	//attribute locations are handed out in order across every added buffer
+	unsigned int m_AttribCount;
+	std::vector<InstanceAttrib> m_InstanceAttribs;
 public:
 	VertexArray();
 	~VertexArray();
@@ -15,4 +30,8 @@ public:
 	void UnBind() const;
 
 	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+	//start the instanced attributes "baseInstance" instances into their buffers, for drivers that can't
+	//pass a base instance to the draw (no ARB_base_instance). 0 goes back to the offsets of AddBuffer
+	void SetBaseInstance(unsigned int baseInstance) const;
+	inline bool HasInstanceAttribs() const { return !m_InstanceAttribs.empty(); }
 };
\ No newline at end of file
@@ -1,16 +1,29 @@
 #include "VertexBuffer.h"
 
 #include "Renderer.h"
+#include "GLStateCache.h"
 
 VertexBuffer::VertexBuffer(const void* data, unsigned int size)
+    :m_Size(size)
 {
     GLCall(glGenBuffers(1, &m_RendererID));
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    Bind();
     GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW));
 }
 
+VertexBuffer::VertexBuffer(unsigned int regionSize, unsigned int regionCount)
+    :m_Size(regionSize * regionCount)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    Bind();
+    m_Ring.Create(GL_ARRAY_BUFFER, regionSize, regionCount);
+}
+
 VertexBuffer::~VertexBuffer()
 {
+    Bind();
+    m_Ring.Release();
+    GLStateCache::Get().OnDeleteBuffer(m_RendererID);
     GLCall(glDeleteBuffers(1, &m_RendererID));
 }
 
@@ -20,12 +33,23 @@ void VertexBuffer::SetData(int offset, unsigned int size, const void* data)
     GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
 }
 
+void* VertexBuffer::BeginRegion()
+{
+    return m_Ring.BeginRegion();
+}
+
+void VertexBuffer::CommitRegion(unsigned int size)
+{
+    Bind();
+    m_Ring.CommitRegion(size);
+}
+
 void VertexBuffer::Bind() const
 {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 }
 
 void VertexBuffer::UnBind() const
 {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -1,14 +1,34 @@
 #pragma once
 
+#include "BufferRing.h"
+
 class VertexBuffer
 {
 private:
 	unsigned int m_RendererID;
+	unsigned int m_Size;
+	//streaming mode: the buffer is split into regions that are written round robin
+	BufferRing m_Ring;
 public:
 	VertexBuffer(const void* data, unsigned int size);
+	//streaming buffer with "regionCount" regions of "regionSize" bytes each
+	VertexBuffer(unsigned int regionSize, unsigned int regionCount);
 	~VertexBuffer();
 
 	void SetData(int offset, unsigned int size, const void* data);
 	void Bind() const;
 	void UnBind() const;
+
+	//streaming: move to the next region, wait until the GPU is done with it and return where to write
+	void* BeginRegion();
+	//streaming: make the first "size" bytes written since BeginRegion visible to the GPU
+	void CommitRegion(unsigned int size);
+
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline unsigned int GetSize() const { return m_Size; }
+	inline unsigned int GetRegionOffset() const { return m_Ring.GetRegionOffset(); }
+	inline unsigned int GetRegionSize() const { return m_Ring.GetRegionCount() ? m_Ring.GetRegionSize() : m_Size; }
+	inline bool IsPersistent() const { return m_Ring.IsPersistent(); }
+	//number of times BeginRegion had to block on a fence
+	inline unsigned int GetStallCount() const { return m_Ring.GetStallCount(); }
 };
\ No newline at end of file
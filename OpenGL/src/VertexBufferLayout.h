@@ -10,6 +10,8 @@ struct VertexBufferElement
 	unsigned int type;
 	unsigned int count;
 	unsigned char normalized;
+	//0 advances per vertex, n advances once every n instances
+	unsigned int divisor;
 
 	static unsigned int GetSizeOfGLType(unsigned int type)
 	{
@@ -36,29 +38,29 @@ public:
 	{}
 
 	template<typename T>
-	void Push(unsigned int cout)
+	void Push(unsigned int /*count*/, unsigned int /*instanceStepRate*/ = 0)
 	{
 		static_assert(false);
 	}
 
 	template<>
-	void Push<float>(unsigned int count)
+	void Push<float>(unsigned int count, unsigned int instanceStepRate)
 	{
-		m_Elements.push_back({GL_FLOAT, count, GL_FALSE});
+		m_Elements.push_back({GL_FLOAT, count, GL_FALSE, instanceStepRate});
 		m_Stride += VertexBufferElement::GetSizeOfGLType(GL_FLOAT) * count;
 	}
 
 	template<>
-	void Push<unsigned int>(unsigned int count)
+	void Push<unsigned int>(unsigned int count, unsigned int instanceStepRate)
 	{
-		m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE });
+		m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE, instanceStepRate });
 		m_Stride += VertexBufferElement::GetSizeOfGLType(GL_UNSIGNED_INT) * count;
 	}
 
 	template<>
-	void Push<unsigned char>(unsigned int count)
+	void Push<unsigned char>(unsigned int count, unsigned int instanceStepRate)
 	{
-		m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE });
+		m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE, instanceStepRate });
 		m_Stride += VertexBufferElement::GetSizeOfGLType(GL_UNSIGNED_BYTE) * count;
 	}
 
@@ -0,0 +1,89 @@
+#include "TestAsyncTexture.h"
+
+#include "Renderer.h"
+#include "TextureLoader.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace test {
+
+	static const char* const s_FilePaths[] = {
+		"res/texture/mmexport1558393548469.jpg",
+		"res/texture/texture_test.png",
+		"res/texture/ChernoLogo.png"
+	};
+	static const int FileCount = sizeof(s_FilePaths) / sizeof(s_FilePaths[0]);
+
+	TestAsyncTexture::TestAsyncTexture()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_Async(true), m_Copies(4),
+		m_LastFrame(std::chrono::high_resolution_clock::now()), m_FrameTime(0.0f), m_WorstFrameTime(0.0f)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		Reload();
+	}
+	TestAsyncTexture::~TestAsyncTexture()
+	{
+	}
+	void TestAsyncTexture::Reload()
+	{
+		m_Textures.clear();
+		for (int copy = 0; copy < m_Copies; copy++)
+		{
+			for (int i = 0; i < FileCount; i++)
+			{
+				if (m_Async)
+					m_Textures.push_back(TextureLoader::Get().Load(s_FilePaths[i]));
+				else
+					m_Textures.push_back(std::make_shared<Texture>(s_FilePaths[i]));
+			}
+		}
+		m_WorstFrameTime = 0.0f;
+	}
+	void TestAsyncTexture::OnUpdate(float deltaTime)
+	{
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point now = clock::now();
+		m_FrameTime = std::chrono::duration<float, std::milli>(now - m_LastFrame).count();
+		m_LastFrame = now;
+
+		if (m_FrameTime > m_WorstFrameTime)
+			m_WorstFrameTime = m_FrameTime;
+	}
+	void TestAsyncTexture::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Renderer->ResetStats();
+		m_Renderer->BeginScene(m_Proj);
+
+		const int perRow = 4;
+		const float size = 1280.0f / perRow;
+		for (size_t i = 0; i < m_Textures.size(); i++)
+		{
+			glm::vec2 position((i % perRow) * size, (i / perRow) * size);
+			m_Renderer->DrawQuad(position, { size - 4.0f, size - 4.0f }, *m_Textures[i]);
+		}
+
+		m_Renderer->EndScene();
+	}
+	void TestAsyncTexture::OnImGuiRender()
+	{
+		ImGui::Checkbox("Async", &m_Async);
+		bool pixelBuffer = TextureLoader::Get().IsUsingPixelBuffer();
+		if (ImGui::Checkbox("Stream through pixel buffer", &pixelBuffer))
+			TextureLoader::Get().SetUsePixelBuffer(pixelBuffer);
+		ImGui::SliderInt("Copies", &m_Copies, 1, 8);
+		if (ImGui::Button("Reload"))
+			Reload();
+
+		ImGui::Text("Frame: %.2f ms, Worst since reload: %.2f ms", m_FrameTime, m_WorstFrameTime);
+
+		const TextureLoader::Stats& stats = TextureLoader::Get().GetStats();
+		ImGui::Text("Pending: %u, Uploaded: %u, Failed: %u", TextureLoader::Get().GetPendingCount(), stats.Uploaded, stats.Failed);
+		ImGui::Text("Last upload pass: %u images, %.2f MB in %.2f ms", stats.LastUploads,
+			stats.LastUploadBytes / (1024.0f * 1024.0f), stats.LastUploadTime);
+		ImGui::Text("Pixel buffer stalls: %u", stats.PixelBufferStalls);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "Texture.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//loads the large images in res/texture either synchronously or through the TextureLoader
+	//and records the worst frame time seen while they come in
+	class TestAsyncTexture : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::vector<std::shared_ptr<Texture> > m_Textures;
+
+		glm::mat4 m_Proj;
+		bool m_Async;
+		int m_Copies;
+
+		std::chrono::high_resolution_clock::time_point m_LastFrame;
+		float m_FrameTime;
+		float m_WorstFrameTime;
+	public:
+		TestAsyncTexture();
+		~TestAsyncTexture();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void Reload();
+	};
+}
\ No newline at end of file
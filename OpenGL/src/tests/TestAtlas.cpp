@@ -0,0 +1,78 @@
+#include "TestAtlas.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace test {
+
+	static const int SpriteCount = 256;
+
+	TestAtlas::TestAtlas()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_UseAtlas(true)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		m_Atlas = std::make_shared<AtlasBuilder>(1024, 2);
+
+		//procedural sprites between 16 and 128 texels, a bright border shows any bleeding
+		std::vector<unsigned char> pixels;
+		for (int sprite = 0; sprite < SpriteCount; sprite++)
+		{
+			int width = 16 + (sprite * 37) % 113;
+			int height = 16 + (sprite * 53) % 113;
+			pixels.resize(width * height * 4);
+			for (int y = 0; y < height; y++)
+			{
+				for (int x = 0; x < width; x++)
+				{
+					bool border = x == 0 || y == 0 || x == width - 1 || y == height - 1;
+					unsigned char* p = &pixels[(y * width + x) * 4];
+					p[0] = border ? 255 : (unsigned char)(sprite * 37);
+					p[1] = border ? 255 : (unsigned char)(sprite * 91);
+					p[2] = border ? 255 : (unsigned char)(sprite * 13 + 128);
+					p[3] = 255;
+				}
+			}
+			m_SpriteIDs.push_back(m_Atlas->Add(width, height, pixels.data()));
+			m_Textures.push_back(std::make_shared<Texture>(width, height, pixels.data()));
+		}
+
+		m_Atlas->Build();
+	}
+	TestAtlas::~TestAtlas()
+	{
+	}
+	void TestAtlas::OnUpdate(float deltaTime)
+	{
+	}
+	void TestAtlas::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Renderer->ResetStats();
+		m_Renderer->BeginScene(m_Proj);
+
+		const int perRow = 16;
+		const float size = 960.0f / perRow;
+		for (int sprite = 0; sprite < SpriteCount; sprite++)
+		{
+			glm::vec2 position((sprite % perRow) * size, (sprite / perRow) * size);
+			if (m_UseAtlas && m_SpriteIDs[sprite] >= 0)
+				m_Renderer->DrawQuad(position, { size, size }, m_Atlas->GetSubTexture(m_SpriteIDs[sprite]));
+			else
+				m_Renderer->DrawQuad(position, { size, size }, *m_Textures[sprite]);
+		}
+
+		m_Renderer->EndScene();
+	}
+	void TestAtlas::OnImGuiRender()
+	{
+		ImGui::Checkbox("Atlas", &m_UseAtlas);
+		ImGui::Text("Atlas pages: %u, mip levels: %d", m_Atlas->GetPageCount(), m_Atlas->GetMipLevels());
+
+		const BatchRenderer2D::Stats& stats = m_Renderer->GetStats();
+		ImGui::Text("Sprites: %u, Draw calls: %u", stats.QuadCount, stats.DrawCalls);
+	}
+}
\ No newline at end of file
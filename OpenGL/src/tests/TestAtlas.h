@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "AtlasBuilder.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//sprites of mixed sizes packed into an atlas versus one texture per sprite
+	class TestAtlas : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::shared_ptr<AtlasBuilder> m_Atlas;
+		std::vector<std::shared_ptr<Texture> > m_Textures;
+		std::vector<int> m_SpriteIDs;
+
+		glm::mat4 m_Proj;
+		bool m_UseAtlas;
+	public:
+		TestAtlas();
+		~TestAtlas();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "TestBindless.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace test {
+
+	static const int TileSize = 32;
+	static const int TextureCount = 1024;
+
+	TestBindless::TestBindless()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)),
+		m_Supported(Texture::IsBindlessSupported()), m_Bindless(m_Supported), m_TileCount(TextureCount)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		m_Renderer->SetBindless(m_Bindless);
+
+		//procedural tiles: stripes with a different color and width each
+		std::vector<unsigned char> pixels(TileSize * TileSize * 4);
+		for (int tile = 0; tile < TextureCount; tile++)
+		{
+			int width = 2 + tile % 7 * 2;
+			for (int y = 0; y < TileSize; y++)
+			{
+				for (int x = 0; x < TileSize; x++)
+				{
+					bool on = ((x + y) / width) % 2 == 0;
+					unsigned char* p = &pixels[(y * TileSize + x) * 4];
+					p[0] = on ? (unsigned char)(tile * 53) : 24;
+					p[1] = on ? (unsigned char)(tile * 29 + 64) : 24;
+					p[2] = on ? (unsigned char)(tile * 7 + 128) : 24;
+					p[3] = 255;
+				}
+			}
+			m_Textures.push_back(std::make_shared<Texture>(TileSize, TileSize, pixels.data()));
+		}
+	}
+	TestBindless::~TestBindless()
+	{
+	}
+	void TestBindless::OnUpdate(float deltaTime)
+	{
+	}
+	void TestBindless::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Renderer->ResetStats();
+		m_Renderer->BeginScene(m_Proj);
+
+		const int perRow = 32;
+		const float size = 960.0f / perRow;
+		for (int tile = 0; tile < m_TileCount; tile++)
+		{
+			glm::vec2 position((tile % perRow) * size, (tile / perRow % perRow) * size);
+			m_Renderer->DrawQuad(position, { size, size }, *m_Textures[tile % TextureCount]);
+		}
+
+		m_Renderer->EndScene();
+	}
+	void TestBindless::OnImGuiRender()
+	{
+		if (!m_Supported)
+			ImGui::Text("ARB_bindless_texture is not supported, using texture slots");
+		else if (ImGui::Checkbox("Bindless textures", &m_Bindless))
+			m_Renderer->SetBindless(m_Bindless);
+
+		ImGui::SliderInt("Tiles", &m_TileCount, 1, TextureCount);
+
+		const BatchRenderer2D::Stats& stats = m_Renderer->GetStats();
+		ImGui::Text("Tiles: %u, Draw calls: %u", stats.QuadCount, stats.DrawCalls);
+		ImGui::Text("%.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
\ No newline at end of file
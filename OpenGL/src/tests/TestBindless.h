@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//one texture per tile, batched through texture slots or through bindless handles
+	class TestBindless : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::vector<std::shared_ptr<Texture> > m_Textures;
+
+		glm::mat4 m_Proj;
+		bool m_Supported;
+		bool m_Bindless;
+		int m_TileCount;
+	public:
+		TestBindless();
+		~TestBindless();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "TestCompressedTexture.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <chrono>
+
+namespace test {
+
+	//the containers are made with TextureConverter res/texture/texture_test.png <file> --format <format>
+	static const char* const s_FilePaths[] = {
+		"res/texture/texture_test.png",
+		"res/texture/texture_test.ktx",
+		"res/texture/texture_test.dds",
+		"res/texture/texture_test_bc7.dds"
+	};
+	static const char* const s_Labels[] = { "PNG", "BC1 KTX", "BC1 DDS", "BC7 DDS" };
+
+	static std::shared_ptr<Texture> LoadTimed(const std::string& filePath, float& time)
+	{
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point start = clock::now();
+		std::shared_ptr<Texture> texture = std::make_shared<Texture>(filePath);
+		GLCall(glFinish());
+		time = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+		return texture;
+	}
+
+	TestCompressedTexture::TestCompressedTexture()
+		:m_LoadTimes(),
+		m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_Zoom(1.0f)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		Load();
+	}
+	TestCompressedTexture::~TestCompressedTexture()
+	{
+	}
+	void TestCompressedTexture::Load()
+	{
+		for (int i = 0; i < FileCount; i++)
+			m_Textures[i] = LoadTimed(s_FilePaths[i], m_LoadTimes[i]);
+	}
+	void TestCompressedTexture::OnUpdate(float deltaTime)
+	{
+	}
+	void TestCompressedTexture::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Renderer->BeginScene(m_Proj);
+
+		//2x2 grid, the PNG at the bottom left
+		const Texture& source = *m_Textures[0];
+		float width = 620.0f * m_Zoom;
+		float height = width * source.GetHeight() / (source.GetWidth() ? source.GetWidth() : 1);
+		for (int i = 0; i < FileCount; i++)
+			m_Renderer->DrawQuad({ 10.0f + (i % 2) * 640.0f, 10.0f + (i / 2) * (height + 20.0f) }, { width, height }, *m_Textures[i]);
+
+		m_Renderer->EndScene();
+	}
+	void TestCompressedTexture::OnImGuiRender()
+	{
+		ImGui::SliderFloat("Zoom", &m_Zoom, 0.05f, 4.0f);
+		if (ImGui::Button("Reload"))
+			Load();
+
+		static const char* const positions[] = { "bottom left", "bottom right", "top left", "top right" };
+		for (int i = 0; i < FileCount; i++)
+		{
+			ImGui::Text("%s (%s): %.2f ms, %.2f MB, %d levels%s", s_Labels[i], positions[i], m_LoadTimes[i],
+				m_Textures[i]->GetMemorySize() / (1024.0f * 1024.0f), m_Textures[i]->GetMipLevels(),
+				m_Textures[i]->IsOriginTop() ? ", top-down" : "");
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "Texture.h"
+
+#include <memory>
+#include <string>
+
+namespace test {
+
+	//the same image as PNG (decoded to RGBA8) and as BC1 KTX, BC1 DDS and BC7 DDS files made by
+	//TextureConverter, in a grid with their load times and video memory. the image is 1400x1157,
+	//so the top-down containers also cover mip levels whose height isn't a multiple of 4
+	class TestCompressedTexture : public Test
+	{
+	private:
+		static const int FileCount = 4;
+
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::shared_ptr<Texture> m_Textures[FileCount];
+		float m_LoadTimes[FileCount];
+
+		glm::mat4 m_Proj;
+		float m_Zoom;
+	public:
+		TestCompressedTexture();
+		~TestCompressedTexture();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void Load();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "TestDynamicTexture.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <chrono>
+#include <math.h>
+
+namespace test {
+
+	static const int ImageSize = 512;
+	static const int RegionSize = 128;
+	static const TextureFormat s_Formats[] = { TextureFormat::RGBA8, TextureFormat::R8 };
+	static const int s_FormatBytes[] = { 4, 1 };
+
+	TestDynamicTexture::TestDynamicTexture()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_Time(0.0f), m_Format(0),
+		m_InPlace(true), m_SubRegion(false), m_UpdateTime(0.0f)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		CreateTexture();
+	}
+	TestDynamicTexture::~TestDynamicTexture()
+	{
+	}
+	void TestDynamicTexture::CreateTexture()
+	{
+		//updated every frame, a mip chain would have to be rebuilt every frame too
+		m_Texture = std::make_unique<Texture>(ImageSize, ImageSize, s_Formats[m_Format], nullptr, SamplerDesc(TextureFilter::Linear), 1);
+		m_Pixels.assign(ImageSize * ImageSize * s_FormatBytes[m_Format], 0);
+	}
+	void TestDynamicTexture::OnUpdate(float deltaTime)
+	{
+		m_Time += deltaTime;
+
+		//plasma, written for every texel even when only a region goes up
+		int bytes = s_FormatBytes[m_Format];
+		for (int y = 0; y < ImageSize; y++)
+		{
+			for (int x = 0; x < ImageSize; x++)
+			{
+				float v = sinf(x * 0.02f + m_Time) + sinf(y * 0.03f - m_Time * 1.3f) + sinf((x + y) * 0.015f + m_Time * 0.7f);
+				unsigned char* p = &m_Pixels[(y * ImageSize + x) * bytes];
+				p[0] = (unsigned char)(127.5f + 42.0f * v);
+				if (bytes == 4)
+				{
+					p[1] = (unsigned char)(127.5f + 42.0f * sinf(v + 2.0f));
+					p[2] = (unsigned char)(127.5f + 42.0f * sinf(v + 4.0f));
+					p[3] = 255;
+				}
+			}
+		}
+	}
+	void TestDynamicTexture::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point start = clock::now();
+		if (!m_InPlace)
+		{
+			m_Texture = std::make_unique<Texture>(ImageSize, ImageSize, s_Formats[m_Format], m_Pixels.data(), SamplerDesc(TextureFilter::Linear), 1);
+		}
+		else if (m_SubRegion)
+		{
+			//a region wandering around the image, rows are read with a stride from the full image
+			int x = (int)((sinf(m_Time) * 0.5f + 0.5f) * (ImageSize - RegionSize));
+			int y = (int)((cosf(m_Time * 0.8f) * 0.5f + 0.5f) * (ImageSize - RegionSize));
+			GLCall(glPixelStorei(GL_UNPACK_ROW_LENGTH, ImageSize));
+			m_Texture->SetData(x, y, RegionSize, RegionSize, &m_Pixels[(y * ImageSize + x) * s_FormatBytes[m_Format]]);
+			GLCall(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+		}
+		else
+		{
+			m_Texture->SetData(0, 0, ImageSize, ImageSize, m_Pixels.data());
+		}
+		m_UpdateTime = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+		m_Renderer->BeginScene(m_Proj);
+		m_Renderer->DrawQuad({ 160.0f, 0.0f }, { 960.0f, 960.0f }, *m_Texture);
+		m_Renderer->EndScene();
+	}
+	void TestDynamicTexture::OnImGuiRender()
+	{
+		static const char* const formats[] = { "RGBA8", "R8" };
+		if (ImGui::Combo("Format", &m_Format, formats, 2))
+			CreateTexture();
+		ImGui::Checkbox("Update in place", &m_InPlace);
+		if (m_InPlace)
+			ImGui::Checkbox("Sub region only", &m_SubRegion);
+
+		ImGui::Text("Update: %.3f ms (%s)", m_UpdateTime, m_InPlace ? "glTexSubImage2D" : "new texture");
+		ImGui::Text("%.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+}
\ No newline at end of file
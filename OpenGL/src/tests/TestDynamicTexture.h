@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//a procedural image rewritten every frame, in place or by reallocating the texture
+	class TestDynamicTexture : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::unique_ptr<Texture> m_Texture;
+		std::vector<unsigned char> m_Pixels;
+
+		glm::mat4 m_Proj;
+		float m_Time;
+		int m_Format;
+		bool m_InPlace;
+		bool m_SubRegion;
+		float m_UpdateTime;
+	public:
+		TestDynamicTexture();
+		~TestDynamicTexture();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void CreateTexture();
+	};
+}
\ No newline at end of file
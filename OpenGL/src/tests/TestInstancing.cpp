@@ -0,0 +1,101 @@
+#include "TestInstancing.h"
+
+#include "Renderer.h"
+#include "QuadIndexBuffer.h"
+#include "CameraBuffer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace test {
+
+	static const int MaxInstanceCount = 200000;
+
+	TestInstancing::TestInstancing()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)),
+		m_InstanceCount(100000), m_UploadedCount(0)
+	{
+		float quad[] = {
+			//position   texture coordinates
+			0.0f, 1.0f,  0.0f, 1.0f,
+			1.0f, 1.0f,  1.0f, 1.0f,
+			1.0f, 0.0f,  1.0f, 0.0f,
+			0.0f, 0.0f,  0.0f, 0.0f
+		};
+
+		m_VAO = std::make_shared<VertexArray>();
+		m_QuadVB = std::make_shared<VertexBuffer>(quad, (unsigned int)sizeof(quad));
+
+		VertexBufferLayout quadLayout;
+		quadLayout.Push<float>(2);//position
+		quadLayout.Push<float>(2);//texture coordinates
+		m_VAO->AddBuffer(*m_QuadVB, quadLayout);
+
+		m_InstanceVB = std::make_shared<VertexBuffer>(nullptr, (unsigned int)(sizeof(SpriteInstance) * MaxInstanceCount));
+
+		VertexBufferLayout instanceLayout;
+		instanceLayout.Push<float>(3, 1);//x, y, size
+		instanceLayout.Push<unsigned char>(4, 1);//tint
+		m_VAO->AddBuffer(*m_InstanceVB, instanceLayout);
+
+		m_Shader = std::make_shared<Shader>("res/shaders/Instanced.shader");
+		m_Shader->Bind();
+		m_Shader->SetUniform1i("u_Texture", 0);
+
+		m_Texture = std::make_shared<Texture>("res/texture/ChernoLogo.png");
+	}
+	TestInstancing::~TestInstancing()
+	{
+	}
+	void TestInstancing::OnUpdate(float deltaTime)
+	{
+	}
+	void TestInstancing::UploadInstances()
+	{
+		std::vector<SpriteInstance> instances(m_InstanceCount);
+
+		int side = (int)std::ceil(std::sqrt((float)m_InstanceCount));
+		float size = 960.0f / side;
+		for (int i = 0; i < m_InstanceCount; i++)
+		{
+			SpriteInstance& instance = instances[i];
+			instance.X = (i % side) * size;
+			instance.Y = (i / side) * size;
+			instance.Size = size;
+			instance.Color[0] = (unsigned char)(255 * (i % side) / side);
+			instance.Color[1] = (unsigned char)(255 * (i / side) / side);
+			instance.Color[2] = 255;
+			instance.Color[3] = 255;
+		}
+
+		m_InstanceVB->SetData(0, (unsigned int)(sizeof(SpriteInstance) * instances.size()), instances.data());
+		m_UploadedCount = m_InstanceCount;
+	}
+	void TestInstancing::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		if (m_UploadedCount != m_InstanceCount)
+			UploadInstances();
+
+		m_Shader->Bind();
+		CameraBuffer::SetViewProjection(m_Proj);
+		m_Texture->Bind(0);
+
+		//the first quad of the shared quad index buffer is the unit quad
+		Renderer renderer;
+		renderer.DrawElementsInstanced(*m_VAO, QuadIndexBuffer::Get(1), *m_Shader, m_InstanceCount, { 0, 6, 0 });
+	}
+	void TestInstancing::OnImGuiRender()
+	{
+		ImGui::SliderInt("Instances", &m_InstanceCount, 1, MaxInstanceCount);
+
+		ImGui::Text("Instance data: %.2f MB (%u bytes per sprite)",
+			sizeof(SpriteInstance) * m_InstanceCount / (1024.0f * 1024.0f), (unsigned int)sizeof(SpriteInstance));
+		ImGui::Text("Draw calls: 1");
+	}
+}
\ No newline at end of file
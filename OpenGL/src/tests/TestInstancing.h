@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "VertexBuffer.h"
+#include "VertexArray.h"
+#include "Texture.h"
+#include "Shader.h"
+
+#include <memory>
+
+namespace test {
+
+	struct SpriteInstance
+	{
+		float X, Y, Size;
+		unsigned char Color[4];
+	};
+
+	//draws many copies of one unit quad with a compact per instance buffer and a single draw call
+	class TestInstancing : public Test
+	{
+	private:
+		std::shared_ptr<VertexArray> m_VAO;
+		std::shared_ptr<VertexBuffer> m_QuadVB;
+		std::shared_ptr<VertexBuffer> m_InstanceVB;
+		std::shared_ptr<Shader> m_Shader;
+		std::shared_ptr<Texture> m_Texture;
+
+		glm::mat4 m_Proj;
+		int m_InstanceCount;
+		int m_UploadedCount;
+	public:
+		TestInstancing();
+		~TestInstancing();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void UploadInstances();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "TestMipmaps.h"
+
+#include "Renderer.h"
+#include "MipGenerator.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "stb_image/stb_image.h"
+
+namespace test {
+
+	static const char* const s_FilePath = "res/texture/texture_test.png";
+
+	TestMipmaps::TestMipmaps()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_GridSize(64), m_Squash(1.0f),
+		m_Filter((int)TextureFilter::Trilinear), m_Anisotropy(1.0f), m_MipBuildTime(0.0f), m_CPUMips(false),
+		m_Frame(0), m_GPUTime(0.0f), m_LastFrame(std::chrono::high_resolution_clock::now()), m_FrameTime(0.0f)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		LoadTexture();
+
+		GLCall(glGenQueries(2, m_Queries));
+	}
+	TestMipmaps::~TestMipmaps()
+	{
+		GLCall(glDeleteQueries(2, m_Queries));
+	}
+	void TestMipmaps::LoadTexture()
+	{
+		int width, height, bpp;
+		stbi_set_flip_vertically_on_load_thread(1);
+		unsigned char* pixels = stbi_load(s_FilePath, &width, &height, &bpp, 4);
+		if (!pixels)
+			return;
+
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point start = clock::now();
+		if (m_CPUMips)
+		{
+			//upload the base level without the GPU pass, then every level built on the CPU
+			m_Texture = std::make_shared<Texture>(width, height, nullptr);
+			m_Texture->SetMipData(0, pixels);
+
+			std::vector<std::vector<unsigned char> > chain = MipGenerator::BuildChain(pixels, width, height);
+			for (size_t i = 0; i < chain.size(); i++)
+				m_Texture->SetMipData((int)i + 1, chain[i].data());
+		}
+		else
+		{
+			m_Texture = std::make_shared<Texture>(width, height, pixels);
+		}
+		GLCall(glFinish());
+		m_MipBuildTime = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+		stbi_image_free(pixels);
+		m_Texture->SetSampler(SamplerDesc((TextureFilter)m_Filter, TextureWrap::Clamp, m_Anisotropy));
+	}
+	void TestMipmaps::OnUpdate(float deltaTime)
+	{
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point now = clock::now();
+		m_FrameTime = std::chrono::duration<float, std::milli>(now - m_LastFrame).count();
+		m_LastFrame = now;
+	}
+	void TestMipmaps::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		//result of the query issued two frames ago, skipped until it is available
+		unsigned int query = m_Queries[m_Frame % 2];
+		if (m_Frame >= 2)
+		{
+			GLint available = 0;
+			GLCall(glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available));
+			if (available)
+			{
+				GLuint64 elapsed = 0;
+				GLCall(glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed));
+				m_GPUTime = elapsed / 1000000.0f;
+			}
+		}
+
+		GLCall(glBeginQuery(GL_TIME_ELAPSED, query));
+		m_Renderer->ResetStats();
+		m_Renderer->BeginScene(m_Proj);
+
+		float size = 960.0f / m_GridSize;
+		for (int y = 0; y < m_GridSize; y++)
+		{
+			for (int x = 0; x < m_GridSize; x++)
+				m_Renderer->DrawQuad({ x * size, y * size * m_Squash }, { size, size * m_Squash }, *m_Texture);
+		}
+
+		m_Renderer->EndScene();
+		GLCall(glEndQuery(GL_TIME_ELAPSED));
+		m_Frame++;
+	}
+	void TestMipmaps::OnImGuiRender()
+	{
+		bool changed = false;
+		changed |= ImGui::Combo("Filter", &m_Filter, "Nearest\0Linear (no mips)\0Trilinear\0");
+		changed |= ImGui::SliderFloat("Anisotropy", &m_Anisotropy, 1.0f, SamplerCache::GetMaxAnisotropy());
+		if (changed)
+			m_Texture->SetSampler(SamplerDesc((TextureFilter)m_Filter, TextureWrap::Clamp, m_Anisotropy));
+
+		ImGui::SliderInt("Grid size", &m_GridSize, 1, 256);
+		ImGui::SliderFloat("Squash", &m_Squash, 0.05f, 1.0f);
+
+		if (ImGui::Checkbox("Build mips on the CPU", &m_CPUMips))
+			LoadTexture();
+		ImGui::Text("%d levels, built in %.2f ms", m_Texture->GetMipLevels(), m_MipBuildTime);
+
+		ImGui::Text("Frame: %.2f ms, Grid on the GPU: %.3f ms", m_FrameTime, m_GPUTime);
+		ImGui::Text("Samplers: %u", SamplerCache::GetSamplerCount());
+	}
+}
\ No newline at end of file
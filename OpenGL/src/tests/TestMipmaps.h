@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "Texture.h"
+
+#include <chrono>
+#include <memory>
+
+namespace test {
+
+	//a zoomed out grid of one large texture, to compare filtering with and without mips.
+	//GPU time of the grid comes from a GL_TIME_ELAPSED query read back a frame later.
+	class TestMipmaps : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::shared_ptr<Texture> m_Texture;
+
+		glm::mat4 m_Proj;
+		int m_GridSize;
+		float m_Squash;
+		int m_Filter;
+		float m_Anisotropy;
+		float m_MipBuildTime;
+		bool m_CPUMips;
+
+		//two queries in flight so reading one never waits on the frame that is still drawing
+		unsigned int m_Queries[2];
+		unsigned int m_Frame;
+		float m_GPUTime;
+		std::chrono::high_resolution_clock::time_point m_LastFrame;
+		float m_FrameTime;
+	public:
+		TestMipmaps();
+		~TestMipmaps();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void LoadTexture();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "TestMultiDraw.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace test {
+
+	static const int MaxMeshCount = 20000;
+
+	TestMultiDraw::TestMultiDraw()
+		:m_MeshCount(5000), m_BuiltCount(0), m_UseIndirect(true), m_SubmitTime(0.0f)
+	{
+		m_Shader = std::make_shared<Shader>("res/shaders/Color.shader");
+		m_Commands = std::make_shared<DrawCommandBuffer>(MaxMeshCount);
+	}
+	TestMultiDraw::~TestMultiDraw()
+	{
+	}
+	void TestMultiDraw::OnUpdate(float deltaTime)
+	{
+	}
+	void TestMultiDraw::BuildMeshes()
+	{
+		struct MeshVertex
+		{
+			float Position[2];
+			float Color[3];
+		};
+
+		std::vector<MeshVertex> vertices;
+		//indices are local to each mesh and the base vertex does the rest, so 8 bits are enough
+		std::vector<unsigned char> indices;
+		m_Commands->Clear();
+
+		int side = (int)std::ceil(std::sqrt((float)m_MeshCount));
+		float cell = 2.0f / side;
+		for (int i = 0; i < m_MeshCount; i++)
+		{
+			//regular polygons with 3 to 8 sides, as a triangle fan around the first vertex
+			int sides = 3 + i % 6;
+			float cx = -1.0f + (i % side + 0.5f) * cell;
+			float cy = -1.0f + (i / side + 0.5f) * cell;
+			float r = 0.4f * cell;
+			float red = (float)(i % side) / side, green = (float)(i / side) / side;
+
+			DrawRange range = { (unsigned int)indices.size(), 0, (int)vertices.size() };
+			for (int v = 0; v < sides; v++)
+			{
+				float angle = 6.2831853f * v / sides;
+				vertices.push_back({ { cx + r * std::cos(angle), cy + r * std::sin(angle) }, { red, green, 1.0f } });
+			}
+			for (int v = 1; v + 1 < sides; v++)
+			{
+				indices.push_back(0);
+				indices.push_back((unsigned char)v);
+				indices.push_back((unsigned char)(v + 1));
+			}
+			range.Count = (unsigned int)indices.size() - range.First;
+			m_Commands->Add(range);
+		}
+
+		m_VAO = std::make_shared<VertexArray>();
+		m_VB = std::make_shared<VertexBuffer>(vertices.data(), (unsigned int)(vertices.size() * sizeof(MeshVertex)));
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);//position
+		layout.Push<float>(3);//color
+		m_VAO->AddBuffer(*m_VB, layout);
+
+		m_IB = std::make_shared<IndexBuffer>(indices.data(), (unsigned int)indices.size());
+		m_BuiltCount = m_MeshCount;
+	}
+	void TestMultiDraw::OnRender()
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		if (m_BuiltCount != m_MeshCount)
+			BuildMeshes();
+
+		Renderer renderer;
+		auto start = std::chrono::high_resolution_clock::now();
+		if (m_UseIndirect)
+		{
+			renderer.DrawIndirect(*m_VAO, *m_IB, *m_Shader, *m_Commands);
+		}
+		else
+		{
+			for (const DrawElementsIndirectCommand& command : m_Commands->GetCommands())
+				renderer.Draw(*m_VAO, *m_IB, *m_Shader, { command.FirstIndex, command.Count, command.BaseVertex });
+		}
+		float submitTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		m_SubmitTime += (submitTime - m_SubmitTime) * 0.05f;
+	}
+	void TestMultiDraw::OnImGuiRender()
+	{
+		ImGui::SliderInt("Meshes", &m_MeshCount, 1, MaxMeshCount);
+
+		if (ImGui::RadioButton("Draw indirect", m_UseIndirect))
+			m_UseIndirect = true;
+		if (ImGui::RadioButton("One draw per mesh", !m_UseIndirect))
+			m_UseIndirect = false;
+
+		if (!DrawCommandBuffer::IsSupported())
+			ImGui::Text("ARB_multi_draw_indirect not supported, draw indirect falls back to a loop");
+
+		ImGui::Text("CPU submit: %.3f ms", m_SubmitTime);
+	}
+}
\ No newline at end of file
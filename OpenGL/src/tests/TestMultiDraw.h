@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Test.h"
+
+#include "VertexBuffer.h"
+#include "VertexArray.h"
+#include "IndexBuffer.h"
+#include "DrawCommandBuffer.h"
+#include "Shader.h"
+
+#include <memory>
+
+namespace test {
+
+	//thousands of small meshes packed into one vertex and index buffer, drawn either
+	//with a single multi draw indirect call or with one draw call per mesh
+	class TestMultiDraw : public Test
+	{
+	private:
+		std::shared_ptr<VertexArray> m_VAO;
+		std::shared_ptr<VertexBuffer> m_VB;
+		std::shared_ptr<IndexBuffer> m_IB;
+		std::shared_ptr<Shader> m_Shader;
+		std::shared_ptr<DrawCommandBuffer> m_Commands;
+
+		int m_MeshCount;
+		int m_BuiltCount;
+		bool m_UseIndirect;
+		float m_SubmitTime;
+	public:
+		TestMultiDraw();
+		~TestMultiDraw();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void BuildMeshes();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "TestPremultiply.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <chrono>
+#include <math.h>
+#include <stdlib.h>
+
+namespace test {
+
+	static const int BenchmarkSize = 2048;
+	static const int BenchmarkRuns = 5;
+	static const int SpriteCount = 12;
+
+	TestPremultiply::TestPremultiply()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_UsePremultiplied(true), m_Time(0.0f), m_DrawCalls(0)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		m_Straight = std::make_shared<Texture>("res/texture/ChernoLogo.png");
+		m_Premultiplied = std::make_shared<Texture>("res/texture/ChernoLogo.png", SamplerDesc(), true);
+
+		m_Pixels.resize((size_t)BenchmarkSize * BenchmarkSize * 4);
+		RunBenchmark();
+	}
+	TestPremultiply::~TestPremultiply()
+	{
+		//every other scene draws with straight alpha
+		Renderer renderer;
+		renderer.SetBlendMode(BlendMode::Alpha);
+	}
+	void TestPremultiply::RunBenchmark()
+	{
+		using clock = std::chrono::high_resolution_clock;
+		for (int level = 0; level < 3; level++)
+		{
+			m_ConvertTime[level] = 0.0f;
+			if ((SimdLevel)level > PixelConverter::GetSimdLevel())
+				continue;
+
+			for (int run = 0; run < BenchmarkRuns; run++)
+			{
+				//fresh random pixels for every run, alpha all over the range
+				for (size_t i = 0; i < m_Pixels.size(); i++)
+					m_Pixels[i] = (unsigned char)rand();
+
+				clock::time_point start = clock::now();
+				PixelConverter::Premultiply(m_Pixels.data(), (size_t)BenchmarkSize * BenchmarkSize, (SimdLevel)level);
+				float time = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+				if (run == 0 || time < m_ConvertTime[level])
+					m_ConvertTime[level] = time;
+			}
+		}
+	}
+	void TestPremultiply::OnUpdate(float deltaTime)
+	{
+		m_Time += deltaTime;
+	}
+	void TestPremultiply::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		Renderer renderer;
+		m_Renderer->ResetStats();
+
+		//translucent logos in a row, additive glows moving over them
+		const float size = 200.0f;
+		if (m_UsePremultiplied)
+		{
+			renderer.SetBlendMode(m_Premultiplied->IsPremultiplied() ? BlendMode::Premultiplied : BlendMode::Alpha);
+			m_Renderer->BeginScene(m_Proj);
+			for (int i = 0; i < SpriteCount; i++)
+			{
+				glm::vec2 position((i % 6) * size + 40.0f, (i / 6) * size * 2.0f + 200.0f);
+				if (i % 2 == 0)
+				{
+					//the tint is premultiplied too
+					m_Renderer->DrawQuad(position, { size, size }, *m_Premultiplied, glm::vec4(0.6f, 0.6f, 0.6f, 0.6f));
+				}
+				else
+				{
+					//alpha 0 leaves the destination as is and adds the color
+					position.y += sinf(m_Time + i) * 100.0f;
+					m_Renderer->DrawQuad(position, { size, size }, *m_Premultiplied, glm::vec4(0.2f, 0.6f, 1.0f, 0.0f));
+				}
+			}
+			m_Renderer->EndScene();
+		}
+		else
+		{
+			//the same sprites with straight alpha need a batch and a blend state per kind
+			renderer.SetBlendMode(BlendMode::Alpha);
+			m_Renderer->BeginScene(m_Proj);
+			for (int i = 0; i < SpriteCount; i += 2)
+			{
+				glm::vec2 position((i % 6) * size + 40.0f, (i / 6) * size * 2.0f + 200.0f);
+				m_Renderer->DrawQuad(position, { size, size }, *m_Straight, glm::vec4(1.0f, 1.0f, 1.0f, 0.6f));
+			}
+			m_Renderer->EndScene();
+
+			renderer.SetBlendMode(BlendMode::Additive);
+			m_Renderer->BeginScene(m_Proj);
+			for (int i = 1; i < SpriteCount; i += 2)
+			{
+				glm::vec2 position((i % 6) * size + 40.0f, (i / 6) * size * 2.0f + 200.0f + sinf(m_Time + i) * 100.0f);
+				m_Renderer->DrawQuad(position, { size, size }, *m_Straight, glm::vec4(0.2f, 0.6f, 1.0f, 1.0f));
+			}
+			m_Renderer->EndScene();
+		}
+		m_DrawCalls = m_Renderer->GetStats().DrawCalls;
+
+		renderer.SetBlendMode(BlendMode::Alpha);
+	}
+	void TestPremultiply::OnImGuiRender()
+	{
+		ImGui::Checkbox("Premultiplied alpha", &m_UsePremultiplied);
+		ImGui::Text("Draw calls: %u", m_DrawCalls);
+
+		ImGui::Separator();
+		ImGui::Text("Premultiply %dx%d, best of %d (CPU: %s)", BenchmarkSize, BenchmarkSize, BenchmarkRuns,
+			PixelConverter::GetSimdLevelName(PixelConverter::GetSimdLevel()));
+		for (int level = 0; level < 3; level++)
+		{
+			const char* name = PixelConverter::GetSimdLevelName((SimdLevel)level);
+			if (m_ConvertTime[level] > 0.0f)
+			{
+				float mbPerSecond = BenchmarkSize * BenchmarkSize * 4 / (1024.0f * 1024.0f) / (m_ConvertTime[level] / 1000.0f);
+				ImGui::Text("%-6s %8.3f ms %8.0f MB/s", name, m_ConvertTime[level], mbPerSecond);
+			}
+			else
+			{
+				ImGui::Text("%-6s not supported", name);
+			}
+		}
+		if (ImGui::Button("Run again"))
+			RunBenchmark();
+	}
+}
\ No newline at end of file
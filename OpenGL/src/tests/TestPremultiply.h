@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "PixelConverter.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//premultiply throughput of every SIMD level, and translucent plus additive sprites in one batch
+	class TestPremultiply : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::shared_ptr<Texture> m_Straight;
+		std::shared_ptr<Texture> m_Premultiplied;
+
+		std::vector<unsigned char> m_Pixels;
+		//best of a few runs for each SimdLevel, in milliseconds
+		float m_ConvertTime[3];
+
+		glm::mat4 m_Proj;
+		bool m_UsePremultiplied;
+		float m_Time;
+		unsigned int m_DrawCalls;
+	public:
+		TestPremultiply();
+		~TestPremultiply();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void RunBenchmark();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "TestProgramCache.h"
+
+#include "Renderer.h"
+#include "Shader.h"
+#include "ProgramCache.h"
+#include "imgui/imgui.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	static const char* const s_ShaderPaths[] = {
+		"res/shaders/Basic.shader",
+		"res/shaders/BatchArray.shader",
+		"res/shaders/Color.shader",
+		"res/shaders/Instanced.shader",
+		"res/shaders/Texture.shader"
+	};
+	static const int ShaderCount = sizeof(s_ShaderPaths) / sizeof(s_ShaderPaths[0]);
+
+	TestProgramCache::TestProgramCache()
+		:m_LoadTime(0.0f), m_LastRunCached(false), m_Rounds(4)
+	{
+	}
+	TestProgramCache::~TestProgramCache()
+	{
+		ProgramCache::Get().SetEnabled(true);
+	}
+	void TestProgramCache::LoadShaders(bool useCache)
+	{
+		ProgramCache& cache = ProgramCache::Get();
+		cache.SetEnabled(useCache);
+		cache.ResetStats();
+
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point start = clock::now();
+		for (int round = 0; round < m_Rounds; round++)
+		{
+			std::vector<std::unique_ptr<Shader> > shaders;
+			for (int i = 0; i < ShaderCount; i++)
+				shaders.push_back(std::make_unique<Shader>(s_ShaderPaths[i]));
+			//the link may finish in the background, wait for it like a first draw would
+			GLCall(glFinish());
+		}
+		m_LoadTime = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+		m_LastRunCached = useCache;
+
+		cache.SetEnabled(true);
+	}
+	void TestProgramCache::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+	}
+	void TestProgramCache::OnImGuiRender()
+	{
+		const ProgramCache& cache = ProgramCache::Get();
+		if (!cache.IsSupported())
+		{
+			ImGui::Text("The driver offers no program binary formats");
+			return;
+		}
+
+		ImGui::SliderInt("Rounds", &m_Rounds, 1, 32);
+		if (ImGui::Button("Compile from source"))
+			LoadShaders(false);
+		ImGui::SameLine();
+		if (ImGui::Button("Load from cache"))
+			LoadShaders(true);
+
+		int programs = m_Rounds * ShaderCount;
+		ImGui::Text("%s: %.2f ms, %.3f ms per program", m_LastRunCached ? "Cached" : "Source", m_LoadTime, m_LoadTime / programs);
+
+		const ProgramCache::Stats& stats = cache.GetStats();
+		ImGui::Text("Hits: %u, Misses: %u, Rejected: %u, Stored: %u, Trimmed: %u", stats.Hits, stats.Misses, stats.Rejected,
+			stats.Stored, stats.Trimmed);
+		ImGui::Text("Drivers keep caches of their own, the first run after a driver update shows the real cost");
+	}
+}
\ No newline at end of file
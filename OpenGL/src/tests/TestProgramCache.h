@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Test.h"
+
+namespace test {
+
+	//time to create every shader of the project from source and from cached program binaries
+	class TestProgramCache : public Test
+	{
+	private:
+		//milliseconds for all shaders of the last run
+		float m_LoadTime;
+		bool m_LastRunCached;
+		int m_Rounds;
+	public:
+		TestProgramCache();
+		~TestProgramCache();
+
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void LoadShaders(bool useCache);
+	};
+}
\ No newline at end of file
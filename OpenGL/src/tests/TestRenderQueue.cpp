@@ -0,0 +1,134 @@
+#include "TestRenderQueue.h"
+
+#include "RenderQueue.h"
+#include "QuadIndexBuffer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+namespace test {
+
+	static const unsigned int BenchmarkSizes[3] = { 10000, 100000, 1000000 };
+
+	TestRenderQueue::TestRenderQueue()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)),
+		m_ObjectCount(2000), m_Sorted(true), m_RadixSortTime{}, m_StdSortTime{}
+	{
+		float quad[] = {
+			//position   texture coordinates
+			0.0f, 1.0f,  0.0f, 1.0f,
+			1.0f, 1.0f,  1.0f, 1.0f,
+			1.0f, 0.0f,  1.0f, 0.0f,
+			0.0f, 0.0f,  0.0f, 0.0f
+		};
+
+		m_VAO = std::make_shared<VertexArray>();
+		m_VB = std::make_shared<VertexBuffer>(quad, (unsigned int)sizeof(quad));
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);//position
+		layout.Push<float>(2);//texture coordinates
+		m_VAO->AddBuffer(*m_VB, layout);
+
+		//two programs from the same source, tinted differently
+		for (int i = 0; i < 2; i++)
+		{
+			m_Shaders[i] = std::make_shared<Shader>("res/shaders/Texture.shader");
+			m_Shaders[i]->Bind();
+			m_Shaders[i]->SetUniform1i("u_Texture", 0);
+		}
+		m_Shaders[0]->SetUniform4f("u_Color", 1.0f, 1.0f, 1.0f, 1.0f);
+		m_Shaders[1]->Bind();
+		m_Shaders[1]->SetUniform4f("u_Color", 1.0f, 0.6f, 0.6f, 1.0f);
+
+		m_Textures[0] = std::make_shared<Texture>("res/texture/texture_test.png");
+		m_Textures[1] = std::make_shared<Texture>("res/texture/ChernoLogo.png");
+	}
+	TestRenderQueue::~TestRenderQueue()
+	{
+	}
+	void TestRenderQueue::OnUpdate(float deltaTime)
+	{
+	}
+	void TestRenderQueue::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		const IndexBuffer& ib = QuadIndexBuffer::Get(1);
+
+		int side = (int)std::ceil(std::sqrt((float)m_ObjectCount));
+		float size = 960.0f / side;
+
+		m_Renderer.BeginScene(m_Proj);
+		for (int i = 0; i < m_ObjectCount; i++)
+		{
+			//interleave shaders and textures so submission order is the worst case
+			unsigned int shader = i % 2;
+			unsigned int texture = (i / 2) % 2;
+
+			glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3((i % side) * size, (i / side) * size, 0.0f));
+			transform = glm::scale(transform, glm::vec3(size, size, 1.0f));
+
+			//without sorting every packet gets the same key and submission order is kept
+			uint64_t key = m_Sorted ? SortKey::Make(0, false, m_Shaders[shader]->GetRendererID(), texture, 0.0f) : 0;
+			m_Renderer.Submit(*m_VAO, ib, *m_Shaders[shader], transform, key, m_Textures[texture].get());
+		}
+		m_Renderer.EndScene();
+	}
+	void TestRenderQueue::RunSortBenchmark()
+	{
+		using clock = std::chrono::high_resolution_clock;
+
+		std::mt19937_64 random(42);
+		std::vector<RenderQueue::SortEntry> entries, scratch;
+		for (int i = 0; i < 3; i++)
+		{
+			unsigned int count = BenchmarkSizes[i];
+			std::vector<RenderQueue::SortEntry> source(count);
+			for (unsigned int j = 0; j < count; j++)
+			{
+				std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+				source[j] = { SortKey::Make((unsigned int)(random() % 4), random() % 8 == 0,
+					(unsigned int)(random() % 32), (unsigned int)(random() % 256), depth(random)), j };
+			}
+
+			entries = source;
+			clock::time_point start = clock::now();
+			RenderQueue::RadixSort(entries, scratch);
+			m_RadixSortTime[i] = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+			entries = source;
+			start = clock::now();
+			std::stable_sort(entries.begin(), entries.end(),
+				[](const RenderQueue::SortEntry& a, const RenderQueue::SortEntry& b) { return a.Key < b.Key; });
+			m_StdSortTime[i] = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+		}
+	}
+	void TestRenderQueue::OnImGuiRender()
+	{
+		ImGui::SliderInt("Objects", &m_ObjectCount, 1, 10000);
+		ImGui::Checkbox("Sort by key", &m_Sorted);
+
+		if (const RenderQueue* queue = m_Renderer.GetQueue())
+		{
+			const RenderQueue::Stats& stats = queue->GetStats();
+			ImGui::Text("Packets: %u, sort: %.3f ms", stats.Packets, stats.SortTime);
+			ImGui::Text("State changes: %u (submission order: %u, saved: %u)", stats.StateChanges,
+				stats.UnsortedStateChanges, stats.UnsortedStateChanges - stats.StateChanges);
+		}
+
+		if (ImGui::Button("Run sort benchmark"))
+			RunSortBenchmark();
+		for (int i = 0; i < 3; i++)
+		{
+			ImGui::Text("%7u packets: radix %.3f ms, std::stable_sort %.3f ms",
+				BenchmarkSizes[i], m_RadixSortTime[i], m_StdSortTime[i]);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "VertexArray.h"
+#include "Texture.h"
+#include "Shader.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//submits objects with mixed shaders and textures through the sorted render queue
+	class TestRenderQueue : public Test
+	{
+	private:
+		std::shared_ptr<VertexArray> m_VAO;
+		std::shared_ptr<VertexBuffer> m_VB;
+		std::shared_ptr<Shader> m_Shaders[2];
+		std::shared_ptr<Texture> m_Textures[2];
+		Renderer m_Renderer;
+
+		glm::mat4 m_Proj;
+		int m_ObjectCount;
+		bool m_Sorted;
+
+		//radix sort cost for 10k, 100k and 1M packets, with std::sort as reference
+		float m_RadixSortTime[3];
+		float m_StdSortTime[3];
+	public:
+		TestRenderQueue();
+		~TestRenderQueue();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void RunSortBenchmark();
+	};
+}
\ No newline at end of file
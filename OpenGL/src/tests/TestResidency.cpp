@@ -0,0 +1,90 @@
+#include "TestResidency.h"
+
+#include "Renderer.h"
+#include "TextureResidency.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace test {
+
+	static const char* const s_FilePaths[] = {
+		"res/texture/texture_test.png",
+		"res/texture/mmexport1558393548469.jpg",
+		"res/texture/texture_test.dds"
+	};
+	static const int FileCount = sizeof(s_FilePaths) / sizeof(s_FilePaths[0]);
+	static const int TextureCount = 24;
+	static const int PageSize = 6;
+	static const int PageCount = TextureCount / PageSize;
+
+	TestResidency::TestResidency()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_Page(0), m_BudgetMB(64), m_EvictedSize(32),
+		m_CyclePages(false), m_PageTime(0.0f)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+
+		//separate copies on purpose, each one takes its own video memory
+		for (int i = 0; i < TextureCount; i++)
+			m_Textures.push_back(std::make_shared<Texture>(s_FilePaths[i % FileCount]));
+
+		TextureResidency::Get().SetBudget((size_t)m_BudgetMB * 1024 * 1024);
+		TextureResidency::Get().SetEvictedSize(m_EvictedSize);
+		TextureResidency::Get().ResetStats();
+	}
+	TestResidency::~TestResidency()
+	{
+		//the manager is shared by every scene
+		TextureResidency::Get().SetBudget(0);
+	}
+	void TestResidency::OnUpdate(float deltaTime)
+	{
+		if (!m_CyclePages)
+			return;
+
+		m_PageTime += deltaTime;
+		if (m_PageTime >= 1.0f)
+		{
+			m_PageTime = 0.0f;
+			m_Page = (m_Page + 1) % PageCount;
+		}
+	}
+	void TestResidency::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Renderer->ResetStats();
+		m_Renderer->BeginScene(m_Proj);
+
+		const int perRow = 3;
+		const float size = 1280.0f / 4;
+		for (int i = 0; i < PageSize; i++)
+		{
+			glm::vec2 position((i % perRow) * size, (i / perRow) * size);
+			m_Renderer->DrawQuad(position, { size - 4.0f, size - 4.0f }, *m_Textures[m_Page * PageSize + i]);
+		}
+
+		m_Renderer->EndScene();
+	}
+	void TestResidency::OnImGuiRender()
+	{
+		TextureResidency& residency = TextureResidency::Get();
+
+		ImGui::SliderInt("Page", &m_Page, 0, PageCount - 1);
+		ImGui::Checkbox("Cycle pages", &m_CyclePages);
+		if (ImGui::SliderInt("Budget (MB)", &m_BudgetMB, 0, 512))
+			residency.SetBudget((size_t)m_BudgetMB * 1024 * 1024);
+		if (ImGui::SliderInt("Evicted size", &m_EvictedSize, 1, 256))
+			residency.SetEvictedSize(m_EvictedSize);
+		if (ImGui::Button("Reset stats"))
+			residency.ResetStats();
+
+		const TextureResidency::Stats& stats = residency.GetStats();
+		ImGui::Text("Resident: %.1f MB in %u textures, %u evicted%s", stats.ResidentBytes / (1024.0f * 1024.0f),
+			stats.TextureCount, stats.EvictedCount, stats.OverBudget ? " (over budget)" : "");
+		ImGui::Text("Evictions: %u, Reloads: %u, Failed: %u, Pending: %u", stats.Evictions, stats.Reloads, stats.FailedReloads,
+			stats.PendingReloads);
+		ImGui::Text("Reload latency: %.2f ms, worst: %.2f ms", stats.LastReloadLatency, stats.MaxReloadLatency);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//more texture memory than the budget allows, only one page of it drawn at a time
+	class TestResidency : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::vector<std::shared_ptr<Texture> > m_Textures;
+
+		glm::mat4 m_Proj;
+		int m_Page;
+		int m_BudgetMB;
+		int m_EvictedSize;
+		bool m_CyclePages;
+		float m_PageTime;
+	public:
+		TestResidency();
+		~TestResidency();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "TestShaderBatch.h"
+
+#include "Renderer.h"
+#include "ProgramCache.h"
+#include "imgui/imgui.h"
+
+#include <stdio.h>
+#include <vector>
+
+namespace test {
+
+	TestShaderBatch::TestShaderBatch()
+		:m_Run(0), m_ProgramCount(64), m_CompilerThreads(0), m_SubmitTime(0.0f), m_TotalTime(0.0f),
+		m_LongestStall(0.0f), m_Frames(0), m_LastRunBatched(false)
+	{
+	}
+	TestShaderBatch::~TestShaderBatch()
+	{
+		m_Batch.reset();
+		ProgramCache::Get().SetEnabled(true);
+	}
+	ShaderSource TestShaderBatch::MakeSource(int index) const
+	{
+		//the run and index go into the source, so neither our cache nor the driver's has seen it before
+		char fragment[1024];
+		snprintf(fragment, sizeof(fragment),
+			"#version 330 core\n"
+			"layout(location = 0) out vec4 color;\n"
+			"in vec2 v_TexCoord;\n"
+			"const float c_Seed = %u.%d;\n"
+			"void main()\n"
+			"{\n"
+			"    vec3 value = vec3(0.0);\n"
+			"    for (int i = 0; i < 16; i++)\n"
+			"        value += sin(vec3(v_TexCoord * float(i), c_Seed) * 3.7 + value.zxy);\n"
+			"    color = vec4(fract(value), 1.0);\n"
+			"}\n", m_Run, index);
+
+		ShaderSource source;
+		source.VertexSource =
+			"#version 330 core\n"
+			"layout(location = 0) in vec2 position;\n"
+			"out vec2 v_TexCoord;\n"
+			"void main()\n"
+			"{\n"
+			"    v_TexCoord = position;\n"
+			"    gl_Position = vec4(position, 0.0, 1.0);\n"
+			"}\n";
+		source.FragmentSource = fragment;
+		return source;
+	}
+	void TestShaderBatch::CompileSerial()
+	{
+		m_Batch.reset();
+		m_Run++;
+		//throwaway programs, keep them out of the program cache
+		ProgramCache::Get().SetEnabled(false);
+
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point start = clock::now();
+		std::vector<std::unique_ptr<Shader> > shaders;
+		for (int i = 0; i < m_ProgramCount; i++)
+			shaders.push_back(std::make_unique<Shader>(MakeSource(i)));
+		m_TotalTime = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+		m_SubmitTime = m_TotalTime;
+		m_LongestStall = m_TotalTime;
+		m_Frames = 1;
+		m_LastRunBatched = false;
+
+		ProgramCache::Get().SetEnabled(true);
+	}
+	void TestShaderBatch::StartBatch()
+	{
+		m_Run++;
+		ProgramCache::Get().SetEnabled(false);
+		ShaderBatch::SetMaxCompilerThreads(m_CompilerThreads > 0 ? (unsigned int)m_CompilerThreads : 0xffffffff);
+
+		m_Start = std::chrono::high_resolution_clock::now();
+		m_Batch = std::make_unique<ShaderBatch>();
+		for (int i = 0; i < m_ProgramCount; i++)
+			m_Batch->Add(MakeSource(i));
+		m_SubmitTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - m_Start).count();
+		m_LongestStall = 0.0f;
+		m_Frames = 0;
+		m_LastRunBatched = true;
+	}
+	void TestShaderBatch::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		if (!m_Batch || m_Batch->IsDone())
+			return;
+
+		//pick up whatever finished since the last frame, never wait. the time spent in here is what
+		//the batch costs the frame
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point start = clock::now();
+		bool done = m_Batch->Poll();
+		clock::time_point end = clock::now();
+
+		float pollTime = std::chrono::duration<float, std::milli>(end - start).count();
+		if (pollTime > m_LongestStall)
+			m_LongestStall = pollTime;
+		m_Frames++;
+
+		if (done)
+		{
+			m_TotalTime = std::chrono::duration<float, std::milli>(end - m_Start).count();
+			ProgramCache::Get().SetEnabled(true);
+		}
+	}
+	void TestShaderBatch::OnImGuiRender()
+	{
+		ImGui::Text("Parallel shader compile: %s", ShaderBatch::IsParallelSupported() ? "supported" : "not supported, the batch finishes in one frame");
+		ImGui::SliderInt("Programs", &m_ProgramCount, 1, 256);
+		ImGui::SliderInt("Compiler threads (0: driver default)", &m_CompilerThreads, 0, 16);
+
+		bool busy = m_Batch && !m_Batch->IsDone();
+		if (!busy)
+		{
+			if (ImGui::Button("Compile one by one"))
+				CompileSerial();
+			ImGui::SameLine();
+			if (ImGui::Button("Compile as batch"))
+				StartBatch();
+		}
+		else
+		{
+			ImGui::Text("Compiling: %u of %d left", m_Batch->GetPendingCount(), m_ProgramCount);
+		}
+
+		if (!busy && m_Frames > 0)
+		{
+			ImGui::Text("%s: %.2f ms total, %.3f ms per program", m_LastRunBatched ? "Batch" : "One by one", m_TotalTime, m_TotalTime / m_ProgramCount);
+			ImGui::Text("Submit: %.2f ms, frames: %d, longest stall: %.2f ms", m_SubmitTime, m_Frames, m_LongestStall);
+			if (m_LastRunBatched)
+				ImGui::Text("Failed: %u", m_Batch->GetFailedCount());
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Test.h"
+
+#include "ShaderBatch.h"
+
+#include <chrono>
+#include <memory>
+
+namespace test {
+
+	//builds many distinct programs one after another or as one batch finished over several frames
+	class TestShaderBatch : public Test
+	{
+	private:
+		std::unique_ptr<ShaderBatch> m_Batch;
+		std::chrono::high_resolution_clock::time_point m_Start;
+		unsigned int m_Run;
+
+		int m_ProgramCount;
+		int m_CompilerThreads;
+		//milliseconds: submitting the batch, until every program was done, and the longest time a frame spent on it
+		float m_SubmitTime;
+		float m_TotalTime;
+		float m_LongestStall;
+		int m_Frames;
+		bool m_LastRunBatched;
+	public:
+		TestShaderBatch();
+		~TestShaderBatch();
+
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		ShaderSource MakeSource(int index) const;
+		void CompileSerial();
+		void StartBatch();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "TestShaderReload.h"
+
+#include "Renderer.h"
+#include "QuadIndexBuffer.h"
+#include "CameraBuffer.h"
+#include "ShaderReloader.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace test {
+
+	static const char* const s_ShaderPath = "res/shaders/HotReload.shader";
+
+	TestShaderReload::TestShaderReload()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_Time(0.0f), m_FrameIndex(0)
+	{
+		float quad[] = {
+			//position       texture coordinates
+			160.0f, 960.0f,  0.0f, 1.0f,
+			1120.0f, 960.0f, 1.0f, 1.0f,
+			1120.0f, 0.0f,   1.0f, 0.0f,
+			160.0f, 0.0f,    0.0f, 0.0f
+		};
+
+		m_VAO = std::make_shared<VertexArray>();
+		m_VB = std::make_shared<VertexBuffer>(quad, (unsigned int)sizeof(quad));
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);//position
+		layout.Push<float>(2);//texture coordinates
+		m_VAO->AddBuffer(*m_VB, layout);
+
+		//set once on purpose, a reloaded program has to keep them
+		m_Shader = std::make_shared<Shader>(s_ShaderPath);
+		m_Shader->Bind();
+		m_Shader->SetUniform1i("u_Texture", 0);
+		m_Shader->SetUniform4f("u_Tint", 1.0f, 1.0f, 1.0f, 1.0f);
+
+		m_Texture = std::make_shared<Texture>("res/texture/ChernoLogo.png");
+
+		for (int i = 0; i < FrameHistory; i++)
+			m_FrameTimes[i] = 0.0f;
+		ShaderReloader::Get().ResetStats();
+	}
+	TestShaderReload::~TestShaderReload()
+	{
+	}
+	void TestShaderReload::TouchShaderFile()
+	{
+		std::string source;
+		{
+			std::ifstream in(s_ShaderPath, std::ios::binary);
+			source.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+		std::ofstream out(s_ShaderPath, std::ios::binary);
+		out << source;
+	}
+	void TestShaderReload::OnUpdate(float deltaTime)
+	{
+		m_Time += deltaTime;
+		m_FrameTimes[m_FrameIndex] = deltaTime * 1000.0f;
+		m_FrameIndex = (m_FrameIndex + 1) % FrameHistory;
+	}
+	void TestShaderReload::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Shader->Bind();
+		CameraBuffer::SetViewProjection(m_Proj);
+		m_Shader->SetUniform1f("u_Time", m_Time);
+		m_Texture->Bind(0);
+
+		Renderer renderer;
+		renderer.Draw(*m_VAO, QuadIndexBuffer::Get(1), *m_Shader, { 0, 6, 0 });
+	}
+	void TestShaderReload::OnImGuiRender()
+	{
+		ShaderReloader& reloader = ShaderReloader::Get();
+
+		bool enabled = reloader.IsEnabled();
+		if (ImGui::Checkbox("Hot reload", &enabled))
+			reloader.SetEnabled(enabled);
+		ImGui::Text("Edit %s and save (%s)", s_ShaderPath, reloader.IsUsingInotify() ? "inotify" : "polling");
+		if (ImGui::Button("Touch file"))
+			TouchShaderFile();
+		ImGui::SameLine();
+		if (ImGui::Button("Reset stats"))
+			reloader.ResetStats();
+
+		const ShaderReloader::Stats& stats = reloader.GetStats();
+		ImGui::Text("Reloads: %u, Failed: %u, Pending: %u", stats.Reloads, stats.Failures, stats.Pending);
+		ImGui::Text("Latency: %.2f ms (edit noticed -> new program in use)", stats.LastLatency);
+		ImGui::Text("Reloader on the GL thread: %.3f ms, worst %.3f ms", stats.LastUpdateTime, stats.MaxUpdateTime);
+		ImGui::PlotLines("Frame time (ms)", m_FrameTimes, FrameHistory, m_FrameIndex, nullptr, 0.0f, 50.0f, ImVec2(0, 80));
+	}
+}
\ No newline at end of file
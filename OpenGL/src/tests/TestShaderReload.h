@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "VertexBuffer.h"
+#include "VertexArray.h"
+#include "Texture.h"
+#include "Shader.h"
+
+#include <memory>
+
+namespace test {
+
+	//a quad drawn with res/shaders/HotReload.shader, which can be edited while the test runs
+	class TestShaderReload : public Test
+	{
+	private:
+		static const int FrameHistory = 120;
+
+		std::shared_ptr<VertexArray> m_VAO;
+		std::shared_ptr<VertexBuffer> m_VB;
+		std::shared_ptr<Shader> m_Shader;
+		std::shared_ptr<Texture> m_Texture;
+
+		glm::mat4 m_Proj;
+		float m_Time;
+		float m_FrameTimes[FrameHistory];
+		int m_FrameIndex;
+	public:
+		TestShaderReload();
+		~TestShaderReload();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		//write the file back unchanged, as if it had been saved from an editor
+		void TouchShaderFile();
+	};
+}
\ No newline at end of file
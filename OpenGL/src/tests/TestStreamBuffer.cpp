@@ -0,0 +1,126 @@
+#include "TestStreamBuffer.h"
+
+#include "Renderer.h"
+#include "QuadIndexBuffer.h"
+#include "imgui/imgui.h"
+
+#include <cmath>
+
+namespace test {
+
+	static const int MaxQuadCount = 100000;
+	static const unsigned int RegionCount = 3;
+
+	TestStreamBuffer::TestStreamBuffer()
+		:m_QuadCount(50000), m_UsePersistent(true), m_Time(0.0f),
+		m_UploadTime(0.0f), m_FrameTime(0.0f), m_Throughput(0.0f),
+		m_LastFrame(std::chrono::high_resolution_clock::now())
+	{
+		const unsigned int bufferSize = sizeof(StreamVertex) * MaxQuadCount * 4;
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);//position
+		layout.Push<float>(3);//color
+
+		m_SubDataVAO = std::make_shared<VertexArray>();
+		m_SubDataVB = std::make_shared<VertexBuffer>(nullptr, bufferSize);
+		m_SubDataVAO->AddBuffer(*m_SubDataVB, layout);
+
+		m_PersistentVAO = std::make_shared<VertexArray>();
+		m_PersistentVB = std::make_shared<VertexBuffer>(bufferSize, RegionCount);
+		m_PersistentVAO->AddBuffer(*m_PersistentVB, layout);
+
+		m_Shader = std::make_shared<Shader>("res/shaders/Color.shader");
+
+		m_Vertices.resize(MaxQuadCount * 4);
+	}
+	TestStreamBuffer::~TestStreamBuffer()
+	{
+	}
+	void TestStreamBuffer::OnUpdate(float deltaTime)
+	{
+	}
+	void TestStreamBuffer::WriteQuads(StreamVertex* target) const
+	{
+		//a grid of small quads in clip space, colors change every frame so the data is never the same
+		int side = (int)std::ceil(std::sqrt((float)m_QuadCount));
+		float size = 2.0f / side;
+		for (int i = 0; i < m_QuadCount; i++)
+		{
+			float x = -1.0f + (i % side) * size;
+			float y = -1.0f + (i / side) * size;
+			float r = 0.5f + 0.5f * std::sin(m_Time + i * 0.001f);
+			float g = 0.5f + 0.5f * std::cos(m_Time + y);
+
+			target[0] = { { x, y + size }, { r, g, 0.5f } };
+			target[1] = { { x + size, y + size }, { r, g, 0.5f } };
+			target[2] = { { x + size, y }, { r, g, 0.5f } };
+			target[3] = { { x, y }, { r, g, 0.5f } };
+			target += 4;
+		}
+	}
+	void TestStreamBuffer::OnRender()
+	{
+		using clock = std::chrono::high_resolution_clock;
+
+		clock::time_point frameStart = clock::now();
+		float frameTime = std::chrono::duration<float, std::milli>(frameStart - m_LastFrame).count();
+		m_LastFrame = frameStart;
+		m_Time += 0.016f;
+
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		unsigned int size = (unsigned int)(sizeof(StreamVertex) * m_QuadCount * 4);
+		Renderer renderer;
+		const IndexBuffer& ib = QuadIndexBuffer::Get(m_QuadCount);
+
+		clock::time_point uploadStart = clock::now();
+		if (m_UsePersistent)
+		{
+			//vertices go straight into the mapped region, no intermediate copy
+			StreamVertex* target = (StreamVertex*)m_PersistentVB->BeginRegion();
+			WriteQuads(target);
+			m_PersistentVB->CommitRegion(size);
+		}
+		else
+		{
+			WriteQuads(m_Vertices.data());
+			m_SubDataVB->SetData(0, size, m_Vertices.data());
+		}
+		float uploadTime = std::chrono::duration<float, std::milli>(clock::now() - uploadStart).count();
+
+		if (m_UsePersistent)
+		{
+			int baseVertex = (int)(m_PersistentVB->GetRegionOffset() / sizeof(StreamVertex));
+			renderer.Draw(*m_PersistentVAO, ib, *m_Shader, { 0, (unsigned int)m_QuadCount * 6, baseVertex });
+		}
+		else
+		{
+			renderer.Draw(*m_SubDataVAO, ib, *m_Shader, { 0, (unsigned int)m_QuadCount * 6, 0 });
+		}
+
+		const float smoothing = 0.05f;
+		m_UploadTime += (uploadTime - m_UploadTime) * smoothing;
+		m_FrameTime += (frameTime - m_FrameTime) * smoothing;
+		if (m_UploadTime > 0.0f)
+			m_Throughput = (size / (1024.0f * 1024.0f)) / (m_UploadTime / 1000.0f);
+	}
+	void TestStreamBuffer::OnImGuiRender()
+	{
+		ImGui::SliderInt("Quads", &m_QuadCount, 1, MaxQuadCount);
+
+		if (ImGui::RadioButton("glBufferSubData", !m_UsePersistent))
+			m_UsePersistent = false;
+		if (ImGui::RadioButton("Persistent mapped", m_UsePersistent))
+			m_UsePersistent = true;
+
+		if (!m_PersistentVB->IsPersistent())
+			ImGui::Text("ARB_buffer_storage not supported, persistent path falls back to glBufferSubData");
+
+		ImGui::Text("Data: %.2f MB/frame", sizeof(StreamVertex) * m_QuadCount * 4 / (1024.0f * 1024.0f));
+		ImGui::Text("Write + upload: %.3f ms (%.0f MB/s)", m_UploadTime, m_Throughput);
+		ImGui::Text("Frame time: %.3f ms", m_FrameTime);
+		ImGui::Text("Fence stalls: %u", m_PersistentVB->GetStallCount());
+	}
+}
\ No newline at end of file
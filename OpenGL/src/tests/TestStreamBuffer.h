@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Test.h"
+
+#include "VertexBuffer.h"
+#include "VertexArray.h"
+#include "Shader.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	struct StreamVertex
+	{
+		float Position[2];
+		float Color[3];
+	};
+
+	//compares streaming vertices with glBufferSubData against the persistent mapped ring buffer
+	class TestStreamBuffer : public Test
+	{
+	private:
+		std::shared_ptr<VertexArray> m_SubDataVAO;
+		std::shared_ptr<VertexBuffer> m_SubDataVB;
+		std::shared_ptr<VertexArray> m_PersistentVAO;
+		std::shared_ptr<VertexBuffer> m_PersistentVB;
+		std::shared_ptr<Shader> m_Shader;
+
+		//client side copy for the glBufferSubData path
+		std::vector<StreamVertex> m_Vertices;
+
+		int m_QuadCount;
+		bool m_UsePersistent;
+		float m_Time;
+
+		//moving averages
+		float m_UploadTime;
+		float m_FrameTime;
+		float m_Throughput;
+		std::chrono::high_resolution_clock::time_point m_LastFrame;
+	public:
+		TestStreamBuffer();
+		~TestStreamBuffer();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void WriteQuads(StreamVertex* target) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "TestTextureArray.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace test {
+
+	static const int TileSize = 64;
+	static const int TileCount = 256;
+
+	TestTextureArray::TestTextureArray()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_UseArray(true)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		m_TextureArray = std::make_shared<TextureArray>(TileSize, TileSize, TileCount);
+
+		//procedural tiles: checkerboards with a different color and cell size each
+		std::vector<unsigned char> pixels(TileSize * TileSize * 4);
+		for (int tile = 0; tile < TileCount; tile++)
+		{
+			int cell = 4 + tile % 5 * 4;
+			for (int y = 0; y < TileSize; y++)
+			{
+				for (int x = 0; x < TileSize; x++)
+				{
+					bool on = ((x / cell) + (y / cell)) % 2 == 0;
+					unsigned char* p = &pixels[(y * TileSize + x) * 4];
+					p[0] = on ? (unsigned char)(tile * 37) : 32;
+					p[1] = on ? (unsigned char)(tile * 91) : 32;
+					p[2] = on ? (unsigned char)(tile * 13 + 128) : 32;
+					p[3] = 255;
+				}
+			}
+			m_TextureArray->AddLayer(pixels.data());
+			m_Textures.push_back(std::make_shared<Texture>(TileSize, TileSize, pixels.data()));
+		}
+	}
+	TestTextureArray::~TestTextureArray()
+	{
+	}
+	void TestTextureArray::OnUpdate(float deltaTime)
+	{
+	}
+	void TestTextureArray::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Renderer->ResetStats();
+		m_Renderer->BeginScene(m_Proj);
+
+		const int perRow = 16;
+		const float size = 960.0f / perRow;
+		for (int tile = 0; tile < TileCount; tile++)
+		{
+			glm::vec2 position((tile % perRow) * size, (tile / perRow) * size);
+			if (m_UseArray)
+				m_Renderer->DrawQuad(position, { size, size }, *m_TextureArray, tile);
+			else
+				m_Renderer->DrawQuad(position, { size, size }, *m_Textures[tile]);
+		}
+
+		m_Renderer->EndScene();
+	}
+	void TestTextureArray::OnImGuiRender()
+	{
+		ImGui::Checkbox("Texture array", &m_UseArray);
+
+		const BatchRenderer2D::Stats& stats = m_Renderer->GetStats();
+		ImGui::Text("Tiles: %u, Draw calls: %u", stats.QuadCount, stats.DrawCalls);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "TextureArray.h"
+#include "Texture.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//many distinct tiles drawn from one texture array versus one texture per tile
+	class TestTextureArray : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::shared_ptr<TextureArray> m_TextureArray;
+		std::vector<std::shared_ptr<Texture> > m_Textures;
+
+		glm::mat4 m_Proj;
+		bool m_UseArray;
+	public:
+		TestTextureArray();
+		~TestTextureArray();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	};
+}
\ No newline at end of file
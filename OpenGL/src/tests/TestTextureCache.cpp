@@ -0,0 +1,82 @@
+#include "TestTextureCache.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace test {
+
+	static const char* const s_FilePaths[] = {
+		"res/texture/mmexport1558393548469.jpg",
+		"res/texture/texture_test.png",
+		"res/texture/ChernoLogo.png"
+	};
+	static const int FileCount = sizeof(s_FilePaths) / sizeof(s_FilePaths[0]);
+
+	TestTextureCache::TestTextureCache()
+		:m_LoadTimes(FileCount, 0.0f), m_TotalTime(0.0f), m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f))
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		m_Cache = std::make_shared<TextureCache>();
+		Reload();
+	}
+	TestTextureCache::~TestTextureCache()
+	{
+	}
+	void TestTextureCache::Reload()
+	{
+		m_Textures.clear();
+		m_TotalTime = 0.0f;
+		for (int i = 0; i < FileCount; i++)
+		{
+			std::shared_ptr<Texture> texture = m_Cache->Load(s_FilePaths[i], m_Options);
+			if (texture)
+				m_Textures.push_back(texture);
+
+			m_LoadTimes[i] = m_Cache->GetStats().LastLoadTime;
+			m_TotalTime += m_LoadTimes[i];
+		}
+	}
+	void TestTextureCache::OnUpdate(float deltaTime)
+	{
+	}
+	void TestTextureCache::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		//every texture of a reload was made with the same options
+		Renderer renderer;
+		if (!m_Textures.empty() && m_Textures[0]->IsPremultiplied())
+			renderer.SetBlendMode(BlendMode::Premultiplied);
+
+		m_Renderer->BeginScene(m_Proj);
+		for (size_t i = 0; i < m_Textures.size(); i++)
+			m_Renderer->DrawQuad({ 10.0f + i * 420.0f, 300.0f }, { 400.0f, 400.0f }, *m_Textures[i]);
+		m_Renderer->EndScene();
+
+		renderer.SetBlendMode(BlendMode::Alpha);
+	}
+	void TestTextureCache::OnImGuiRender()
+	{
+		ImGui::Checkbox("Premultiply", &m_Options.Premultiply);
+		ImGui::Checkbox("Store mips", &m_Options.Mips);
+
+		if (ImGui::Button("Reload"))
+			Reload();
+		ImGui::SameLine();
+		if (ImGui::Button("Clear cache"))
+		{
+			for (int i = 0; i < FileCount; i++)
+				m_Cache->Remove(s_FilePaths[i], m_Options);
+		}
+
+		for (int i = 0; i < FileCount; i++)
+			ImGui::Text("%s: %.2f ms", s_FilePaths[i], m_LoadTimes[i]);
+		ImGui::Text("Total: %.2f ms", m_TotalTime);
+
+		const TextureCache::Stats& stats = m_Cache->GetStats();
+		ImGui::Text("Hits: %u (%u by content hash), Misses: %u", stats.Hits, stats.Revalidated, stats.Misses);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "TextureCache.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//loads the images in res/texture through the decoded texture cache, cold after "Clear cache"
+	//and warm on every later "Reload"
+	class TestTextureCache : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::shared_ptr<TextureCache> m_Cache;
+		std::vector<std::shared_ptr<Texture> > m_Textures;
+		std::vector<float> m_LoadTimes;
+		float m_TotalTime;
+
+		glm::mat4 m_Proj;
+		TextureCacheOptions m_Options;
+	public:
+		TestTextureCache();
+		~TestTextureCache();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void Reload();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "TestTextureLibrary.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <chrono>
+#include <unordered_set>
+
+namespace test {
+
+	static const char* const s_FilePaths[] = {
+		"res/texture/texture_test.png",
+		"res/texture/ChernoLogo.png",
+		//same file through a different path, still one texture in the library
+		"res/texture/../texture/ChernoLogo.png"
+	};
+	static const int FileCount = sizeof(s_FilePaths) / sizeof(s_FilePaths[0]);
+
+	TestTextureLibrary::TestTextureLibrary()
+		:m_Proj(glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f)), m_SpriteCount(30), m_UseLibrary(true),
+		m_LoadTime(0.0f), m_UniqueTextures(0), m_MemorySize(0)
+	{
+		m_Renderer = std::make_shared<BatchRenderer2D>();
+		Reload();
+	}
+	TestTextureLibrary::~TestTextureLibrary()
+	{
+	}
+	void TestTextureLibrary::Reload()
+	{
+		//release the old sprites first, so the library can't hand them out again
+		m_Sprites.clear();
+		TextureLibrary::Get().ResetStats();
+
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point start = clock::now();
+		for (int i = 0; i < m_SpriteCount; i++)
+		{
+			const char* filePath = s_FilePaths[i % FileCount];
+			if (m_UseLibrary)
+				m_Sprites.push_back(TextureLibrary::Get().Load(filePath));
+			else
+				m_Sprites.push_back(std::make_shared<Texture>(filePath));
+		}
+		m_LoadTime = std::chrono::duration<float, std::milli>(clock::now() - start).count();
+
+		std::unordered_set<unsigned int> textures;
+		m_MemorySize = 0;
+		for (const std::shared_ptr<Texture>& sprite : m_Sprites)
+		{
+			if (textures.insert(sprite->GetRendererID()).second)
+				m_MemorySize += sprite->GetMemorySize();
+		}
+		m_UniqueTextures = (unsigned int)textures.size();
+	}
+	void TestTextureLibrary::OnUpdate(float deltaTime)
+	{
+	}
+	void TestTextureLibrary::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Renderer->ResetStats();
+		m_Renderer->BeginScene(m_Proj);
+
+		const int perRow = 10;
+		const float size = 1280.0f / perRow;
+		for (size_t i = 0; i < m_Sprites.size(); i++)
+		{
+			glm::vec2 position((i % perRow) * size, (i / perRow) * size);
+			m_Renderer->DrawQuad(position, { size - 4.0f, size - 4.0f }, *m_Sprites[i]);
+		}
+
+		m_Renderer->EndScene();
+	}
+	void TestTextureLibrary::OnImGuiRender()
+	{
+		ImGui::Checkbox("Texture library", &m_UseLibrary);
+		ImGui::SliderInt("Sprites", &m_SpriteCount, 1, 70);
+		if (ImGui::Button("Reload"))
+			Reload();
+
+		ImGui::Text("Load: %.2f ms, GL textures: %u, %.2f MB", m_LoadTime, m_UniqueTextures, m_MemorySize / (1024.0f * 1024.0f));
+
+		const TextureLibrary::Stats& stats = TextureLibrary::Get().GetStats();
+		ImGui::Text("Library hits: %u, misses: %u, live: %u", stats.Hits, stats.Misses, TextureLibrary::Get().GetLiveCount());
+		ImGui::Text("Draw calls: %u", m_Renderer->GetStats().DrawCalls);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "BatchRenderer2D.h"
+#include "TextureLibrary.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//many sprites referencing a few image files, each loading its texture either
+	//through the TextureLibrary or with its own Texture
+	class TestTextureLibrary : public Test
+	{
+	private:
+		std::shared_ptr<BatchRenderer2D> m_Renderer;
+		std::vector<std::shared_ptr<Texture> > m_Sprites;
+
+		glm::mat4 m_Proj;
+		int m_SpriteCount;
+		bool m_UseLibrary;
+		float m_LoadTime;
+		unsigned int m_UniqueTextures;
+		size_t m_MemorySize;
+	public:
+		TestTextureLibrary();
+		~TestTextureLibrary();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void Reload();
+	};
+}
\ No newline at end of file
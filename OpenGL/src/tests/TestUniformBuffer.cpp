@@ -0,0 +1,216 @@
+#include "TestUniformBuffer.h"
+
+#include "Renderer.h"
+#include "QuadIndexBuffer.h"
+#include "CameraBuffer.h"
+#include "imgui/imgui.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <stdio.h>
+
+namespace test {
+
+	static const int MaxPrograms = 64;
+
+	static const char* const s_LayoutBlock =
+		"layout(std140) uniform LayoutCheck\n"
+		"{\n"
+		"    float a;\n"
+		"    vec3 b;\n"
+		"    float c;\n"
+		"    vec2 d;\n"
+		"    float e[3];\n"
+		"    vec3 f[2];\n"
+		"    mat4 g;\n"
+		"    int h;\n"
+		"    float i[1];\n"
+		"};\n";
+
+	TestUniformBuffer::TestUniformBuffer()
+		:m_ProgramCount(32), m_UseBlock(true), m_Angle(0.0f), m_CameraTime(0.0f), m_CameraCalls(0)
+	{
+		float quad[] = {
+			0.0f, 1.0f,
+			1.0f, 1.0f,
+			1.0f, 0.0f,
+			0.0f, 0.0f
+		};
+
+		m_VAO = std::make_shared<VertexArray>();
+		m_VB = std::make_shared<VertexBuffer>(quad, (unsigned int)sizeof(quad));
+
+		VertexBufferLayout layout;
+		layout.Push<float>(2);//position
+		m_VAO->AddBuffer(*m_VB, layout);
+
+		CreatePrograms();
+
+		//must declare the members in the same order as s_LayoutBlock
+		m_Layout.Push<float>("a");
+		m_Layout.Push<glm::vec3>("b");
+		m_Layout.Push<float>("c");
+		m_Layout.Push<glm::vec2>("d");
+		m_Layout.Push<float>("e", 3);
+		m_Layout.Push<glm::vec3>("f", 2);
+		m_Layout.Push<glm::mat4>("g");
+		m_Layout.Push<int>("h");
+		m_Layout.Push<float>("i", 1, true);
+		QueryDriverOffsets();
+	}
+	TestUniformBuffer::~TestUniformBuffer()
+	{
+	}
+	void TestUniformBuffer::CreatePrograms()
+	{
+		//the offset of each quad is baked into its program, so the camera is the only uniform input
+		for (int i = 0; i < MaxPrograms; i++)
+		{
+			char vertex[1024];
+			char fragment[512];
+			float x = 80.0f + (i % 8) * 140.0f;
+			float y = 60.0f + (i / 8) * 110.0f;
+			snprintf(fragment, sizeof(fragment),
+				"#version 330 core\n"
+				"layout(location = 0) out vec4 color;\n"
+				"void main()\n"
+				"{\n"
+				"    color = vec4(%f, %f, %f, 1.0);\n"
+				"}\n", (i % 4) / 3.0f, ((i / 4) % 4) / 3.0f, (i / 16) / 3.0f);
+
+			for (int block = 0; block < 2; block++)
+			{
+				snprintf(vertex, sizeof(vertex),
+					"#version 330 core\n"
+					"layout(location = 0) in vec2 position;\n"
+					"%s"
+					"void main()\n"
+					"{\n"
+					"    gl_Position = %s * vec4(position * 100.0 + vec2(%f, %f), 0.0, 1.0);\n"
+					"}\n",
+					block ? "layout(std140) uniform Camera\n{\n    mat4 u_ViewProjection;\n};\n" : "uniform mat4 u_MVP;\n",
+					block ? "u_ViewProjection" : "u_MVP", x, y);
+
+				ShaderSource source;
+				source.VertexSource = vertex;
+				source.FragmentSource = fragment;
+				if (block)
+				{
+					m_BlockShaders.push_back(std::make_unique<Shader>(source));
+				}
+				else
+				{
+					m_PlainShaders.push_back(std::make_unique<Shader>(source));
+					m_MVPHandles.push_back(m_PlainShaders.back()->GetUniform("u_MVP"));
+				}
+			}
+		}
+
+		ShaderSource source;
+		source.VertexSource = std::string(
+			"#version 330 core\n"
+			"layout(location = 0) in vec2 position;\n") + s_LayoutBlock +
+			"void main()\n"
+			"{\n"
+			"    gl_Position = g * vec4(position, a + c + d.x + e[0] + e[1] + e[2] + float(h) + i[0], 1.0) + vec4(b + f[0] + f[1], 0.0);\n"
+			"}\n";
+		source.FragmentSource =
+			"#version 330 core\n"
+			"layout(location = 0) out vec4 color;\n"
+			"void main()\n"
+			"{\n"
+			"    color = vec4(1.0);\n"
+			"}\n";
+		m_LayoutShader = std::make_unique<Shader>(source);
+	}
+	void TestUniformBuffer::QueryDriverOffsets()
+	{
+		//arrays are asked for by the name of their first element
+		std::vector<std::string> names;
+		for (const UniformBufferElement& element : m_Layout.GetElements())
+			names.push_back(element.array ? element.name + "[0]" : element.name);
+		std::vector<const char*> pointers;
+		for (const std::string& name : names)
+			pointers.push_back(name.c_str());
+
+		unsigned int program = m_LayoutShader->GetRendererID();
+		std::vector<unsigned int> indices(names.size(), GL_INVALID_INDEX);
+		m_DriverOffsets.assign(names.size(), -1);
+		if (!program)
+			return;
+
+		GLCall(glGetUniformIndices(program, (int)names.size(), pointers.data(), indices.data()));
+		for (size_t i = 0; i < indices.size(); i++)
+		{
+			if (indices[i] != GL_INVALID_INDEX)
+			{
+				GLCall(glGetActiveUniformsiv(program, 1, &indices[i], GL_UNIFORM_OFFSET, &m_DriverOffsets[i]));
+			}
+		}
+	}
+	void TestUniformBuffer::OnUpdate(float deltaTime)
+	{
+		m_Angle += deltaTime * 0.5f;
+	}
+	void TestUniformBuffer::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		//rotate around the center of the grid, the matrix changes every frame
+		glm::mat4 proj = glm::ortho(0.0f, 1280.0f, 0.0f, 960.0f, -1.0f, 1.0f);
+		glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(640.0f, 480.0f, 0.0f));
+		view = glm::rotate(view, 0.1f * sinf(m_Angle), glm::vec3(0.0f, 0.0f, 1.0f));
+		view = glm::translate(view, glm::vec3(-640.0f, -480.0f, 0.0f));
+		glm::mat4 viewProjection = proj * view;
+
+		using clock = std::chrono::high_resolution_clock;
+		clock::time_point start = clock::now();
+		if (m_UseBlock)
+		{
+			CameraBuffer::SetViewProjection(viewProjection);
+			m_CameraCalls = 1;
+		}
+		else
+		{
+			for (int i = 0; i < m_ProgramCount; i++)
+			{
+				m_PlainShaders[i]->Bind();
+				m_PlainShaders[i]->SetUniformMat4f(m_MVPHandles[i], viewProjection);
+			}
+			m_CameraCalls = m_ProgramCount;
+		}
+		m_CameraTime = std::chrono::duration<float, std::micro>(clock::now() - start).count();
+
+		Renderer renderer;
+		const IndexBuffer& ib = QuadIndexBuffer::Get(1);
+		for (int i = 0; i < m_ProgramCount; i++)
+		{
+			const Shader& shader = m_UseBlock ? *m_BlockShaders[i] : *m_PlainShaders[i];
+			renderer.Draw(*m_VAO, ib, shader, { 0, 6, 0 });
+		}
+	}
+	void TestUniformBuffer::OnImGuiRender()
+	{
+		ImGui::SliderInt("Programs", &m_ProgramCount, 1, MaxPrograms);
+		ImGui::Checkbox("Shared Camera block", &m_UseBlock);
+		ImGui::Text("Camera: %u %s, %.1f us", m_CameraCalls, m_UseBlock ? "buffer upload" : "glUniformMatrix4fv calls", m_CameraTime);
+		ImGui::Text("Camera block uploads so far: %u", CameraBuffer::GetUploadCount());
+
+		if (ImGui::TreeNode("std140 layout check"))
+		{
+			const std::vector<UniformBufferElement>& elements = m_Layout.GetElements();
+			for (size_t i = 0; i < elements.size(); i++)
+			{
+				const UniformBufferElement& element = elements[i];
+				bool match = m_DriverOffsets[i] == -1 || m_DriverOffsets[i] == (int)element.offset;
+				ImGui::TextColored(match ? ImVec4(1.0f, 1.0f, 1.0f, 1.0f) : ImVec4(1.0f, 0.3f, 0.3f, 1.0f),
+					"%s: offset %u, stride %u, driver %d", element.name.c_str(), element.offset, element.stride, m_DriverOffsets[i]);
+			}
+			ImGui::Text("Block size: %u bytes", m_Layout.GetSize());
+			ImGui::TreePop();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Test.h"
+
+#include "glm/glm.hpp"
+
+#include "VertexBuffer.h"
+#include "VertexArray.h"
+#include "Shader.h"
+#include "UniformBufferLayout.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	//many programs drawn under one moving camera, the matrix either set on every program
+	//or uploaded once to the shared Camera block. also checks the std140 layout builder
+	//against the offsets the driver reports
+	class TestUniformBuffer : public Test
+	{
+	private:
+		std::shared_ptr<VertexArray> m_VAO;
+		std::shared_ptr<VertexBuffer> m_VB;
+		//one program per quad, declaring the Camera block or a plain "u_MVP"
+		std::vector<std::unique_ptr<Shader> > m_BlockShaders;
+		std::vector<std::unique_ptr<Shader> > m_PlainShaders;
+		std::vector<UniformHandle> m_MVPHandles;
+
+		//program declaring a block with members of every type the layout builder knows
+		std::unique_ptr<Shader> m_LayoutShader;
+		UniformBufferLayout m_Layout;
+		std::vector<int> m_DriverOffsets;
+
+		int m_ProgramCount;
+		bool m_UseBlock;
+		float m_Angle;
+		//microseconds spent getting the matrix to the programs this frame, and GL calls for it
+		float m_CameraTime;
+		unsigned int m_CameraCalls;
+	public:
+		TestUniformBuffer();
+		~TestUniformBuffer();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void CreatePrograms();
+		void QueryDriverOffsets();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "TestUniformThroughput.h"
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include <chrono>
+
+namespace test {
+
+	TestUniformThroughput::TestUniformThroughput()
+		:m_CallCount(20000), m_Frames(0)
+	{
+		m_Shader = std::make_unique<Shader>("res/shaders/Basic.shader");
+		m_ColorHandle = m_Shader->GetUniform("u_Color");
+		m_ColorLocation = m_Shader->GetUniforms()[m_ColorHandle.Index].Location;
+		for (int i = 0; i < PathCount; i++)
+			m_CallTime[i] = 0.0f;
+	}
+	TestUniformThroughput::~TestUniformThroughput()
+	{
+	}
+	int TestUniformThroughput::OldUniformLocation(const std::string& name)
+	{
+		if (m_OldCache.find(name) != m_OldCache.end())
+			return m_OldCache[name];
+
+		GLCall(int location = glGetUniformLocation(m_Shader->GetRendererID(), name.c_str()));
+		if (location != -1)
+			m_OldCache[name] = location;
+		return location;
+	}
+	void TestUniformThroughput::OnRender()
+	{
+		GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Shader->Bind();
+
+		using clock = std::chrono::high_resolution_clock;
+		float times[PathCount];
+		for (int path = 0; path < PathCount; path++)
+		{
+			clock::time_point start = clock::now();
+			for (int i = 0; i < m_CallCount; i++)
+			{
+				float value = (float)i / m_CallCount;
+				switch (path)
+				{
+				case StringTwice:
+					GLCall(glUniform4f(OldUniformLocation("u_Color"), value, value, value, 1.0f));
+					break;
+				case StringOnce:
+					m_Shader->SetUniform4f("u_Color", value, value, value, 1.0f);
+					break;
+				case Handle:
+					m_Shader->SetUniform4f(m_ColorHandle, value, value, value, 1.0f);
+					break;
+				default:
+					GLCall(glUniform4f(m_ColorLocation, value, value, value, 1.0f));
+					break;
+				}
+			}
+			times[path] = std::chrono::duration<float, std::nano>(clock::now() - start).count() / m_CallCount;
+		}
+
+		m_Frames++;
+		for (int path = 0; path < PathCount; path++)
+			m_CallTime[path] += (times[path] - m_CallTime[path]) / m_Frames;
+	}
+	void TestUniformThroughput::OnImGuiRender()
+	{
+		if (ImGui::SliderInt("Calls per path and frame", &m_CallCount, 1000, 200000))
+		{
+			m_Frames = 0;
+			for (int i = 0; i < PathCount; i++)
+				m_CallTime[i] = 0.0f;
+		}
+
+		ImGui::Text("By name, two lookups (before): %.1f ns per call", m_CallTime[StringTwice]);
+		ImGui::Text("By name, one lookup:           %.1f ns per call", m_CallTime[StringOnce]);
+		ImGui::Text("By handle:                     %.1f ns per call", m_CallTime[Handle]);
+		ImGui::Text("Raw location:                  %.1f ns per call", m_CallTime[Location]);
+		ImGui::Text("Averaged over %d frames", m_Frames);
+
+		ImGui::Separator();
+		//the first one reports the missing uniform, later ones hit the cached miss and stay quiet
+		if (ImGui::Button("Set a missing uniform 1000 times"))
+		{
+			m_Shader->Bind();
+			for (int i = 0; i < 1000; i++)
+				m_Shader->SetUniform1f("u_Missing", 1.0f);
+		}
+
+		if (ImGui::TreeNode("Reflected uniforms"))
+		{
+			for (const UniformInfo& uniform : m_Shader->GetUniforms())
+				ImGui::Text("%s: location %d, type 0x%x, count %d", uniform.Name.c_str(), uniform.Location, uniform.Type, uniform.Count);
+			ImGui::TreePop();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Test.h"
+
+#include "Shader.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace test {
+
+	//cost of one uniform upload through the different lookup paths
+	class TestUniformThroughput : public Test
+	{
+	private:
+		enum Path
+		{
+			//the lookup the shader used before: a temporary string and two hash lookups per call
+			StringTwice,
+			StringOnce,
+			Handle,
+			//glUniform on a location kept by the caller, the floor for the others
+			Location,
+			PathCount
+		};
+
+		std::unique_ptr<Shader> m_Shader;
+		UniformHandle m_ColorHandle;
+		int m_ColorLocation;
+		std::unordered_map<std::string, int> m_OldCache;
+
+		int m_CallCount;
+		//nanoseconds per call, averaged over the frames so far
+		float m_CallTime[PathCount];
+		int m_Frames;
+	public:
+		TestUniformThroughput();
+		~TestUniformThroughput();
+
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		int OldUniformLocation(const std::string& name);
+	};
+}
\ No newline at end of file
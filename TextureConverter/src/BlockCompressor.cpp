@@ -0,0 +1,384 @@
+#include "BlockCompressor.h"
+
+#include <string.h>
+
+static unsigned short PackRGB565(int r, int g, int b)
+{
+	return (unsigned short)(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+static void UnpackRGB565(unsigned short color, int* rgb)
+{
+	int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+	rgb[0] = (r << 3) | (r >> 2);
+	rgb[1] = (g << 2) | (g >> 4);
+	rgb[2] = (b << 3) | (b >> 2);
+}
+
+//appends "count" bits of "value" to a block written from its least significant bit up
+static void WriteBits(unsigned char* out, int& position, unsigned int value, int count)
+{
+	for (int i = 0; i < count; i++, position++)
+	{
+		if (value & (1u << i))
+			out[position / 8] |= (unsigned char)(1 << (position % 8));
+	}
+}
+
+void BlockCompressor::FetchBlock(const unsigned char* pixels, int width, int height, int blockX, int blockY, unsigned char* block)
+{
+	for (int y = 0; y < 4; y++)
+	{
+		int py = blockY * 4 + y;
+		py = py < height ? py : height - 1;
+		for (int x = 0; x < 4; x++)
+		{
+			int px = blockX * 4 + x;
+			px = px < width ? px : width - 1;
+			memcpy(block + (y * 4 + x) * 4, pixels + (py * width + px) * 4, 4);
+		}
+	}
+}
+
+void BlockCompressor::EncodeColor(const unsigned char* block, bool allowAlpha, unsigned char* out)
+{
+	int minColor[3] = { 255, 255, 255 }, maxColor[3] = { 0, 0, 0 };
+	bool transparent = false;
+	for (int i = 0; i < 16; i++)
+	{
+		const unsigned char* texel = block + i * 4;
+		if (allowAlpha && texel[3] < 128)
+		{
+			transparent = true;
+			continue;
+		}
+		for (int c = 0; c < 3; c++)
+		{
+			if (texel[c] < minColor[c]) minColor[c] = texel[c];
+			if (texel[c] > maxColor[c]) maxColor[c] = texel[c];
+		}
+	}
+	//fully transparent block
+	if (minColor[0] > maxColor[0])
+	{
+		minColor[0] = minColor[1] = minColor[2] = 0;
+		maxColor[0] = maxColor[1] = maxColor[2] = 0;
+	}
+
+	//the box diagonal runs from min to max on every axis, flip the axes that correlate
+	//negatively with green so the endpoints follow the actual color spread
+	int center[3], covariance[3] = { 0, 0, 0 };
+	for (int c = 0; c < 3; c++)
+		center[c] = (minColor[c] + maxColor[c]) / 2;
+	for (int i = 0; i < 16; i++)
+	{
+		const unsigned char* texel = block + i * 4;
+		int g = texel[1] - center[1];
+		covariance[0] += (texel[0] - center[0]) * g;
+		covariance[2] += (texel[2] - center[2]) * g;
+	}
+	for (int c = 0; c < 3; c += 2)
+	{
+		if (covariance[c] < 0)
+		{
+			int t = minColor[c];
+			minColor[c] = maxColor[c];
+			maxColor[c] = t;
+		}
+	}
+
+	//pull the endpoints in by 1/16 of the range, the palette then covers the texels more evenly
+	for (int c = 0; c < 3; c++)
+	{
+		int inset = (maxColor[c] - minColor[c]) / 16;
+		minColor[c] += inset;
+		maxColor[c] -= inset;
+	}
+
+	unsigned short color0 = PackRGB565(maxColor[0], maxColor[1], maxColor[2]);
+	unsigned short color1 = PackRGB565(minColor[0], minColor[1], minColor[2]);
+	//color0 > color1 selects the 4 color mode, color0 <= color1 the 3 color + transparent mode
+	if ((color0 < color1) != transparent)
+	{
+		unsigned short t = color0;
+		color0 = color1;
+		color1 = t;
+	}
+
+	int palette[4][3];
+	UnpackRGB565(color0, palette[0]);
+	UnpackRGB565(color1, palette[1]);
+	int paletteSize = 4;
+	for (int c = 0; c < 3; c++)
+	{
+		if (color0 > color1)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		else
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			paletteSize = 3;
+		}
+	}
+
+	unsigned int indices = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		const unsigned char* texel = block + i * 4;
+		unsigned int best = 3;
+		if (!(transparent && texel[3] < 128))
+		{
+			int bestDistance = 0x7fffffff;
+			for (int p = 0; p < paletteSize; p++)
+			{
+				int dr = texel[0] - palette[p][0], dg = texel[1] - palette[p][1], db = texel[2] - palette[p][2];
+				int distance = dr * dr + dg * dg + db * db;
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = p;
+				}
+			}
+		}
+		indices |= best << (i * 2);
+	}
+
+	memcpy(out, &color0, 2);
+	memcpy(out + 2, &color1, 2);
+	memcpy(out + 4, &indices, 4);
+}
+
+void BlockCompressor::EncodeChannel(const unsigned char* block, int channel, unsigned char* out)
+{
+	int minValue = 255, maxValue = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int value = block[i * 4 + channel];
+		if (value < minValue) minValue = value;
+		if (value > maxValue) maxValue = value;
+	}
+
+	//value0 > value1 selects 8 interpolated values, index 0 and 1 are the endpoints
+	int palette[8];
+	palette[0] = maxValue;
+	palette[1] = minValue;
+	for (int i = 1; i < 7; i++)
+		palette[i + 1] = ((7 - i) * maxValue + i * minValue + 3) / 7;
+
+	unsigned long long indices = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int value = block[i * 4 + channel];
+		unsigned long long best = 0;
+		int bestDistance = 256;
+		for (int p = 0; p < 8; p++)
+		{
+			int distance = value > palette[p] ? value - palette[p] : palette[p] - value;
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				best = p;
+			}
+		}
+		indices |= best << (i * 3);
+	}
+
+	out[0] = (unsigned char)maxValue;
+	out[1] = (unsigned char)minValue;
+	for (int i = 0; i < 6; i++)
+		out[2 + i] = (unsigned char)(indices >> (i * 8));
+}
+
+void BlockCompressor::CompressBC1(const unsigned char* pixels, int width, int height, unsigned char* out)
+{
+	unsigned char block[64];
+	for (int by = 0; by < (height + 3) / 4; by++)
+	{
+		for (int bx = 0; bx < (width + 3) / 4; bx++)
+		{
+			FetchBlock(pixels, width, height, bx, by, block);
+			EncodeColor(block, true, out);
+			out += 8;
+		}
+	}
+}
+
+void BlockCompressor::CompressBC3(const unsigned char* pixels, int width, int height, unsigned char* out)
+{
+	unsigned char block[64];
+	for (int by = 0; by < (height + 3) / 4; by++)
+	{
+		for (int bx = 0; bx < (width + 3) / 4; bx++)
+		{
+			FetchBlock(pixels, width, height, bx, by, block);
+			EncodeChannel(block, 3, out);
+			EncodeColor(block, false, out + 8);
+			out += 16;
+		}
+	}
+}
+
+void BlockCompressor::CompressBC4(const unsigned char* pixels, int width, int height, unsigned char* out)
+{
+	unsigned char block[64];
+	for (int by = 0; by < (height + 3) / 4; by++)
+	{
+		for (int bx = 0; bx < (width + 3) / 4; bx++)
+		{
+			FetchBlock(pixels, width, height, bx, by, block);
+			EncodeChannel(block, 0, out);
+			out += 8;
+		}
+	}
+}
+
+void BlockCompressor::CompressBC5(const unsigned char* pixels, int width, int height, unsigned char* out)
+{
+	unsigned char block[64];
+	for (int by = 0; by < (height + 3) / 4; by++)
+	{
+		for (int bx = 0; bx < (width + 3) / 4; bx++)
+		{
+			FetchBlock(pixels, width, height, bx, by, block);
+			EncodeChannel(block, 0, out);
+			EncodeChannel(block, 1, out + 8);
+			out += 16;
+		}
+	}
+}
+
+void BlockCompressor::EncodeBC7Mode6(const unsigned char* block, unsigned char* out)
+{
+	static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	int minColor[4] = { 255, 255, 255, 255 }, maxColor[4] = { 0, 0, 0, 0 };
+	for (int i = 0; i < 16; i++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			int value = block[i * 4 + c];
+			if (value < minColor[c]) minColor[c] = value;
+			if (value > maxColor[c]) maxColor[c] = value;
+		}
+	}
+
+	//as for BC1, flip the axes that correlate negatively with green
+	int center[4], covariance[4] = { 0, 0, 0, 0 };
+	for (int c = 0; c < 4; c++)
+		center[c] = (minColor[c] + maxColor[c]) / 2;
+	for (int i = 0; i < 16; i++)
+	{
+		int g = block[i * 4 + 1] - center[1];
+		for (int c = 0; c < 4; c++)
+			covariance[c] += (block[i * 4 + c] - center[c]) * g;
+	}
+	for (int c = 0; c < 4; c++)
+	{
+		if (c != 1 && covariance[c] < 0)
+		{
+			int t = minColor[c];
+			minColor[c] = maxColor[c];
+			maxColor[c] = t;
+		}
+	}
+
+	//7 bits per channel plus one p-bit shared by the 4 channels of an endpoint, take the closer p-bit
+	int endpoints[2][4], pbits[2];
+	const int* targets[2] = { minColor, maxColor };
+	for (int e = 0; e < 2; e++)
+	{
+		int bestError = 0x7fffffff;
+		for (int p = 0; p < 2; p++)
+		{
+			int quantized[4], error = 0;
+			for (int c = 0; c < 4; c++)
+			{
+				int q = (targets[e][c] - p + 1) / 2;
+				q = q < 0 ? 0 : (q > 127 ? 127 : q);
+				quantized[c] = q;
+				int d = targets[e][c] - ((q << 1) | p);
+				error += d * d;
+			}
+			if (error < bestError)
+			{
+				bestError = error;
+				pbits[e] = p;
+				memcpy(endpoints[e], quantized, sizeof(quantized));
+			}
+		}
+	}
+
+	int palette[16][4];
+	for (int i = 0; i < 16; i++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			int e0 = (endpoints[0][c] << 1) | pbits[0], e1 = (endpoints[1][c] << 1) | pbits[1];
+			palette[i][c] = ((64 - weights[i]) * e0 + weights[i] * e1 + 32) >> 6;
+		}
+	}
+
+	int indices[16];
+	for (int i = 0; i < 16; i++)
+	{
+		const unsigned char* texel = block + i * 4;
+		int bestDistance = 0x7fffffff;
+		for (int p = 0; p < 16; p++)
+		{
+			int distance = 0;
+			for (int c = 0; c < 4; c++)
+				distance += (texel[c] - palette[p][c]) * (texel[c] - palette[p][c]);
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				indices[i] = p;
+			}
+		}
+	}
+
+	//the first index is stored without its top bit, swap the endpoints when it is set
+	if (indices[0] & 8)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			int t = endpoints[0][c];
+			endpoints[0][c] = endpoints[1][c];
+			endpoints[1][c] = t;
+		}
+		int t = pbits[0];
+		pbits[0] = pbits[1];
+		pbits[1] = t;
+		for (int i = 0; i < 16; i++)
+			indices[i] = 15 - indices[i];
+	}
+
+	//mode 6 is six 0 bits and a 1, then R0 R1 G0 G1 B0 B1 A0 A1, P0 P1 and the indices
+	memset(out, 0, 16);
+	int position = 0;
+	WriteBits(out, position, 1 << 6, 7);
+	for (int c = 0; c < 4; c++)
+	{
+		WriteBits(out, position, endpoints[0][c], 7);
+		WriteBits(out, position, endpoints[1][c], 7);
+	}
+	WriteBits(out, position, pbits[0], 1);
+	WriteBits(out, position, pbits[1], 1);
+	for (int i = 0; i < 16; i++)
+		WriteBits(out, position, indices[i], i == 0 ? 3 : 4);
+}
+
+void BlockCompressor::CompressBC7(const unsigned char* pixels, int width, int height, unsigned char* out)
+{
+	unsigned char block[64];
+	for (int by = 0; by < (height + 3) / 4; by++)
+	{
+		for (int bx = 0; bx < (width + 3) / 4; bx++)
+		{
+			FetchBlock(pixels, width, height, bx, by, block);
+			EncodeBC7Mode6(block, out);
+			out += 16;
+		}
+	}
+}
\ No newline at end of file
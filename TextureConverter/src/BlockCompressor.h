@@ -0,0 +1,25 @@
+#pragma once
+
+//encoders for the BCn block formats, offline quality: bounding box endpoints with a small inset
+//and nearest palette entry per texel. every function reads RGBA8 texels and writes the blocks
+//of a "width" x "height" image row by row; partial edge blocks repeat the edge texels.
+class BlockCompressor
+{
+public:
+	//DXT1, switches a block to 1 bit alpha when any of its texels has alpha below 128
+	static void CompressBC1(const unsigned char* pixels, int width, int height, unsigned char* out);
+	//DXT5: BC1 color plus a BC4 block for alpha
+	static void CompressBC3(const unsigned char* pixels, int width, int height, unsigned char* out);
+	//single channel, the red channel of the input
+	static void CompressBC4(const unsigned char* pixels, int width, int height, unsigned char* out);
+	//two channels, red and green of the input (e.g. normal maps)
+	static void CompressBC5(const unsigned char* pixels, int width, int height, unsigned char* out);
+	//BPTC, mode 6 only: one RGBA line with 16 steps per block, no partitions
+	static void CompressBC7(const unsigned char* pixels, int width, int height, unsigned char* out);
+private:
+	//4x4 RGBA texels of the block at (blockX, blockY)
+	static void FetchBlock(const unsigned char* pixels, int width, int height, int blockX, int blockY, unsigned char* block);
+	static void EncodeColor(const unsigned char* block, bool allowAlpha, unsigned char* out);
+	static void EncodeChannel(const unsigned char* block, int channel, unsigned char* out);
+	static void EncodeBC7Mode6(const unsigned char* block, unsigned char* out);
+};
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+#include "stb_image/stb_image.h"
+
+#include "ImageContainer.h"
+#include "MipGenerator.h"
+#include "BlockCompressor.h"
+
+//offline conversion of PNG/JPEG images into KTX or DDS containers the engine uploads as is.
+//usage: TextureConverter <input> <output.ktx|output.dds> [--format rgba8|bc1|bc3|bc4|bc5|bc7] [--no-mips]
+
+static void PrintUsage()
+{
+	std::cout << "usage: TextureConverter <input> <output.ktx|output.dds> [--format rgba8|bc1|bc3|bc4|bc5|bc7] [--no-mips]" << std::endl;
+}
+
+static bool ParseFormat(const std::string& name, unsigned int& internalFormat)
+{
+	if (name == "rgba8")
+		internalFormat = GL_RGBA8;
+	else if (name == "bc1")
+		internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+	else if (name == "bc3")
+		internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	else if (name == "bc4")
+		internalFormat = GL_COMPRESSED_RED_RGTC1;
+	else if (name == "bc5")
+		internalFormat = GL_COMPRESSED_RG_RGTC2;
+	else if (name == "bc7")
+		internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+	else
+	{
+		std::cout << "Unknown format " << name << std::endl;
+		return false;
+	}
+	return true;
+}
+
+static void Encode(ImageData& image, const unsigned char* pixels, int width, int height)
+{
+	std::vector<unsigned char> blocks(ImageContainer::GetLevelSize(image.InternalFormat, width, height));
+	switch (image.InternalFormat)
+	{
+	case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:	BlockCompressor::CompressBC1(pixels, width, height, blocks.data()); break;
+	case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:	BlockCompressor::CompressBC3(pixels, width, height, blocks.data()); break;
+	case GL_COMPRESSED_RED_RGTC1:			BlockCompressor::CompressBC4(pixels, width, height, blocks.data()); break;
+	case GL_COMPRESSED_RG_RGTC2:			BlockCompressor::CompressBC5(pixels, width, height, blocks.data()); break;
+	case GL_COMPRESSED_RGBA_BPTC_UNORM:		BlockCompressor::CompressBC7(pixels, width, height, blocks.data()); break;
+	default:								ImageContainer::AddLevel(image, width, height, pixels); return;
+	}
+	ImageContainer::AddLevel(image, width, height, blocks.data());
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::string input = argv[1], output = argv[2];
+	unsigned int internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+	bool mips = true;
+	for (int i = 3; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--format" && i + 1 < argc)
+		{
+			if (!ParseFormat(argv[++i], internalFormat))
+				return 1;
+		}
+		else if (arg == "--no-mips")
+			mips = false;
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	std::string extension = output.substr(output.find_last_of('.') + 1);
+	if (extension != "ktx" && extension != "dds")
+	{
+		std::cout << "Output must be a .ktx or .dds file" << std::endl;
+		return 1;
+	}
+
+	//decoded top row first, the order other tools expect and the only one DDS can record
+	int width, height, bpp;
+	unsigned char* pixels = stbi_load(input.c_str(), &width, &height, &bpp, 4);
+	if (!pixels)
+	{
+		std::cout << "Failed to load " << input << std::endl;
+		return 1;
+	}
+
+	ImageData image;
+	image.InternalFormat = internalFormat;
+	image.Width = width;
+	image.Height = height;
+	image.TopDown = true;
+
+	Encode(image, pixels, width, height);
+	if (mips)
+	{
+		std::vector<std::vector<unsigned char> > chain = MipGenerator::BuildChain(pixels, width, height);
+		int w = width, h = height;
+		for (const std::vector<unsigned char>& level : chain)
+		{
+			w = w > 1 ? w / 2 : 1;
+			h = h > 1 ? h / 2 : 1;
+			Encode(image, level.data(), w, h);
+		}
+	}
+	stbi_image_free(pixels);
+
+	bool written = extension == "dds" ? ImageContainer::WriteDDS(output, image) : ImageContainer::WriteKTX(output, image);
+	if (!written)
+		return 1;
+
+	std::cout << output << ": " << width << "x" << height << ", " << image.Levels.size() << " levels, "
+		<< image.Data.size() / 1024 << " KB" << std::endl;
+	return 0;
+}
\ No newline at end of file